@@ -0,0 +1,15 @@
+//
+//  EZFormAsyncValidatorTests.h
+//  EZFormDemoTests
+//
+//  Copyright (c) 2012-2013 Chris Miles. All rights reserved.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+/** Tests asynchronous field validation against an in-process stub of a
+ *  username lookup service with artificial latency.
+ */
+@interface EZFormAsyncValidatorTests : SenTestCase
+
+@end
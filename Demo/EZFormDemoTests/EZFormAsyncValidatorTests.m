@@ -0,0 +1,248 @@
+//
+//  EZFormAsyncValidatorTests.m
+//  EZFormDemoTests
+//
+//  Copyright (c) 2012-2013 Chris Miles. All rights reserved.
+//
+
+#import "EZFormAsyncValidatorTests.h"
+#import <EZForm/EZForm.h>
+
+
+#pragma mark - Username service stub
+
+/* Answers whether a username is free after a per-username latency,
+ * polling isCancelled while it waits like a well behaved network
+ * request would.
+ */
+@interface EZFormAsyncValidatorStubService : NSObject
+@property (nonatomic, copy) NSSet *takenUsernames;
+@property (nonatomic, copy) NSDictionary *latencies;	// username -> NSNumber of seconds
+@property (nonatomic, assign) NSTimeInterval defaultLatency;
+@property (nonatomic, assign) BOOL ignoresCancellation;
+@property (nonatomic, readonly) NSUInteger requestCount;
+@property (nonatomic, readonly) NSUInteger cancelledCount;
+@property (nonatomic, readonly) NSUInteger answeredCount;
+- (EZFormAsyncValidator *)validator;
+@end
+
+@implementation EZFormAsyncValidatorStubService {
+    NSUInteger _requestCount;
+    NSUInteger _cancelledCount;
+    NSUInteger _answeredCount;
+}
+
+- (NSUInteger)requestCount
+{
+    @synchronized(self) {
+	return _requestCount;
+    }
+}
+
+- (NSUInteger)cancelledCount
+{
+    @synchronized(self) {
+	return _cancelledCount;
+    }
+}
+
+- (NSUInteger)answeredCount
+{
+    @synchronized(self) {
+	return _answeredCount;
+    }
+}
+
+- (EZFormAsyncValidator *)validator
+{
+    __weak EZFormAsyncValidatorStubService *weakSelf = self;
+    return [EZFormAsyncValidator asyncValidatorWithBlock:^(id value, BOOL (^isCancelled)(void), EZFormAsyncValidationCompletion completion) {
+	EZFormAsyncValidatorStubService *service = weakSelf;
+	[service lookUpUsername:value isCancelled:isCancelled completion:completion];
+    }];
+}
+
+- (void)lookUpUsername:(NSString *)username isCancelled:(BOOL (^)(void))isCancelled completion:(EZFormAsyncValidationCompletion)completion
+{
+    @synchronized(self) {
+	_requestCount++;
+    }
+    
+    NSNumber *latency = self.latencies[username];
+    NSDate *answerDate = [NSDate dateWithTimeIntervalSinceNow:(latency ? [latency doubleValue] : self.defaultLatency)];
+    while ([answerDate timeIntervalSinceNow] > 0) {
+	if (!self.ignoresCancellation && isCancelled()) {
+	    @synchronized(self) {
+		_cancelledCount++;
+	    }
+	    return;
+	}
+	usleep(1000);
+    }
+    
+    @synchronized(self) {
+	_answeredCount++;
+    }
+    completion(![self.takenUsernames containsObject:username]);
+}
+
+@end
+
+
+#pragma mark - Delegate
+
+@interface EZFormAsyncValidatorTestDelegate : NSObject <EZFormDelegate>
+@property (nonatomic, assign) NSUInteger pendingCount;
+@property (nonatomic, assign) NSUInteger resolvedCount;
+@property (nonatomic, assign) BOOL lastResolvedModelIsValid;
+@end
+
+@implementation EZFormAsyncValidatorTestDelegate
+
+- (void)form:(EZForm *)form didBeginPendingValidationForField:(EZFormField *)formField
+{
+    #pragma unused(form, formField)
+    self.pendingCount++;
+}
+
+- (void)form:(EZForm *)form didResolvePendingValidationForField:(EZFormField *)formField modelIsValid:(BOOL)isValid
+{
+    #pragma unused(form, formField)
+    self.resolvedCount++;
+    self.lastResolvedModelIsValid = isValid;
+}
+
+@end
+
+
+#pragma mark - EZFormAsyncValidatorTests
+
+@interface EZFormAsyncValidatorTests ()
+@property (nonatomic, strong) EZFormAsyncValidatorStubService *service;
+@property (nonatomic, strong) EZFormAsyncValidatorTestDelegate *delegate;
+@property (nonatomic, strong) EZForm *form;
+@property (nonatomic, strong) EZFormGenericField *usernameField;
+@end
+
+@implementation EZFormAsyncValidatorTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.service = [[EZFormAsyncValidatorStubService alloc] init];
+    self.service.takenUsernames = [NSSet setWithObjects:@"admin", @"root", nil];
+    self.service.defaultLatency = 0.05;
+    
+    self.delegate = [[EZFormAsyncValidatorTestDelegate alloc] init];
+    self.form = [[EZForm alloc] init];
+    self.form.delegate = self.delegate;
+    
+    self.usernameField = [[EZFormGenericField alloc] initWithKey:@"username"];
+    self.usernameField.validationNotNil = YES;
+    [self.usernameField addAsyncValidator:[self.service validator]];
+    [self.form addFormField:self.usernameField];
+}
+
+- (void)tearDown
+{
+    self.form = nil;
+    self.delegate = nil;
+    self.service = nil;
+    
+    [super tearDown];
+}
+
+/* Runs the main run loop, which delivers validation results, until the
+ * condition holds or the timeout passes. Returns the final condition.
+ */
+- (BOOL)runMainLoopUntil:(BOOL (^)(void))condition timeout:(NSTimeInterval)timeout
+{
+    NSDate *timeoutDate = [NSDate dateWithTimeIntervalSinceNow:timeout];
+    while (!condition() && [timeoutDate timeIntervalSinceNow] > 0) {
+	[[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+    }
+    return condition();
+}
+
+- (void)runMainLoopFor:(NSTimeInterval)duration
+{
+    [self runMainLoopUntil:^BOOL{ return NO; } timeout:duration];
+}
+
+
+#pragma mark - Tests
+
+- (void)testValidValueIsPendingThenResolvesValid
+{
+    EZFormAsyncValidatorTestDelegate *delegate = self.delegate;
+    self.usernameField.fieldValue = @"alice";
+    
+    STAssertFalse([self.usernameField isValid], @"Expected a pending field to be treated as invalid");
+    STAssertTrue([self.usernameField isValidationPending], @"Expected validation to be pending");
+    STAssertEquals(delegate.pendingCount, (NSUInteger)1, @"Expected one pending message");
+    STAssertEquals(delegate.resolvedCount, (NSUInteger)0, @"Expected no resolved message before the service answers");
+    
+    STAssertTrue([self runMainLoopUntil:^BOOL{ return delegate.resolvedCount > 0; } timeout:2.0], @"Expected validation to resolve");
+    STAssertEquals(delegate.resolvedCount, (NSUInteger)1, @"Expected one resolved message");
+    STAssertTrue(delegate.lastResolvedModelIsValid, @"Expected the form to be valid");
+    STAssertFalse([self.usernameField isValidationPending], @"Expected validation to be resolved");
+    STAssertTrue([self.usernameField isValid], @"Expected a free username to be valid");
+}
+
+- (void)testTakenValueResolvesInvalid
+{
+    EZFormAsyncValidatorTestDelegate *delegate = self.delegate;
+    self.usernameField.fieldValue = @"admin";
+    [self.usernameField isValid];
+    
+    STAssertTrue([self runMainLoopUntil:^BOOL{ return delegate.resolvedCount > 0; } timeout:2.0], @"Expected validation to resolve");
+    STAssertFalse(delegate.lastResolvedModelIsValid, @"Expected the form to be invalid");
+    STAssertFalse([self.usernameField isValid], @"Expected a taken username to be invalid");
+    STAssertEquals([self.usernameField validationReport].failure, EZFormValidationFailureAsyncValidator, @"Expected the async validator to be reported as failing");
+}
+
+- (void)testChangingValueCancelsValidationInFlight
+{
+    EZFormAsyncValidatorStubService *service = self.service;
+    EZFormAsyncValidatorTestDelegate *delegate = self.delegate;
+    service.latencies = @{@"admin": @0.5};
+    
+    self.usernameField.fieldValue = @"admin";
+    [self.usernameField isValid];
+    STAssertTrue([self runMainLoopUntil:^BOOL{ return service.requestCount == 1; } timeout:2.0], @"Expected the first lookup to start");
+    
+    self.usernameField.fieldValue = @"alice";
+    [self.usernameField isValid];
+    
+    STAssertTrue([self runMainLoopUntil:^BOOL{ return service.cancelledCount == 1 && delegate.resolvedCount > 0; } timeout:2.0], @"Expected the first lookup to be cancelled and the second to resolve");
+    STAssertEquals(service.answeredCount, (NSUInteger)1, @"Expected only the second lookup to be answered");
+    STAssertEquals(delegate.resolvedCount, (NSUInteger)1, @"Expected one resolved message");
+    STAssertTrue([self.usernameField isValid], @"Expected the field to be valid for the latest value");
+}
+
+- (void)testStaleResultIsDropped
+{
+    EZFormAsyncValidatorStubService *service = self.service;
+    EZFormAsyncValidatorTestDelegate *delegate = self.delegate;
+    service.ignoresCancellation = YES;
+    service.latencies = @{@"admin": @0.3, @"alice": @0.02};
+    
+    self.usernameField.fieldValue = @"admin";
+    [self.usernameField isValid];
+    STAssertTrue([self runMainLoopUntil:^BOOL{ return service.requestCount == 1; } timeout:2.0], @"Expected the first lookup to start");
+    
+    self.usernameField.fieldValue = @"alice";
+    [self.usernameField isValid];
+    
+    // Both lookups answer; the slow answer for the old value comes last
+    STAssertTrue([self runMainLoopUntil:^BOOL{ return service.answeredCount == 2; } timeout:2.0], @"Expected both lookups to be answered");
+    [self runMainLoopFor:0.1];
+    
+    STAssertEquals(delegate.pendingCount, (NSUInteger)2, @"Expected a pending message per value");
+    STAssertEquals(delegate.resolvedCount, (NSUInteger)1, @"Expected the stale result to be dropped without a resolved message");
+    STAssertTrue(delegate.lastResolvedModelIsValid, @"Expected the form to be valid");
+    STAssertTrue([self.usernameField isValid], @"Expected the stale invalid result not to override the latest value");
+}
+
+@end
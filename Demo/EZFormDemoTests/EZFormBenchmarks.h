@@ -0,0 +1,20 @@
+//
+//  EZFormBenchmarks.h
+//  EZFormDemoTests
+//
+//  Copyright (c) 2012-2013 Chris Miles. All rights reserved.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+/** Benchmarks the form engine hot paths with forms of 10 to 100,000
+ *  fields, using mock views.
+ *
+ *  Results are written as JSON to the path in the EZFORM_BENCHMARK_OUTPUT
+ *  environment variable, or to EZFormBenchmarks.json in the temporary
+ *  directory. Set EZFORM_BENCHMARK_MAX_FIELDS to limit the largest form
+ *  size.
+ */
+@interface EZFormBenchmarks : SenTestCase
+
+@end
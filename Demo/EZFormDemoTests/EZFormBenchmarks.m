@@ -0,0 +1,1079 @@
+//
+//  EZFormBenchmarks.m
+//  EZFormDemoTests
+//
+//  Copyright (c) 2012-2013 Chris Miles. All rights reserved.
+//
+
+#import "EZFormBenchmarks.h"
+#import <EZForm/EZForm.h>
+#import <EZForm/EZFormChoicePageCache.h>
+#import <malloc/malloc.h>
+#import <mach/mach.h>
+#import <mach/mach_error.h>
+#import <pthread.h>
+
+
+#pragma mark - Mock views
+
+/* A label that only stores its text. */
+@interface EZFormBenchmarkLabel : UIView
+@property (nonatomic, copy) NSString *text;
+@end
+
+@implementation EZFormBenchmarkLabel
+@end
+
+/* A text field that stores its text without any layout, so very long
+ * documents can be passed to the UITextFieldDelegate methods cheaply.
+ */
+@interface EZFormBenchmarkTextField : UITextField {
+    NSString *benchmarkText;
+}
+@end
+
+@implementation EZFormBenchmarkTextField
+
+- (NSString *)text
+{
+    return benchmarkText;
+}
+
+- (void)setText:(NSString *)text
+{
+    benchmarkText = [text copy];
+}
+
+@end
+
+
+#pragma mark - Private access
+
+/* The bundle has no test host, so UIControl actions are not delivered
+ * (they route through the nil shared application). Keystrokes call the
+ * field's editing handler directly instead.
+ */
+@interface EZFormTextField (EZFormBenchmarkAccess)
+- (void)textFieldAllEditingEvents:(id)sender;
+@end
+
+
+#pragma mark - Choice data source stub
+
+/* An in-process choice data source that adds artificial latency to each
+ * fetch, standing in for a remote catalog.
+ */
+@interface EZFormBenchmarkSlowChoiceDataSource : NSObject <EZFormChoiceDataSource>
+@property (nonatomic, strong) EZFormChoiceStore *store;
+@property (nonatomic, assign) useconds_t latency;
+@property (nonatomic, assign) NSUInteger fetchCount;
+@end
+
+@implementation EZFormBenchmarkSlowChoiceDataSource
+
+- (NSUInteger)numberOfChoices
+{
+    return [self.store numberOfChoices];
+}
+
+- (void)getChoiceKeys:(NSArray **)keys values:(NSArray **)values inRange:(NSRange)range
+{
+    self.fetchCount++;
+    usleep(self.latency);
+    [self.store getChoiceKeys:keys values:values inRange:range];
+}
+
+- (id)choiceValueForKey:(id)key
+{
+    usleep(self.latency);
+    return [self.store choiceValueForKey:key];
+}
+
+@end
+
+
+#pragma mark - Model object
+
+@interface EZFormBenchmarkModel : NSObject
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, strong) EZFormBenchmarkModel *parent;
+@property (nonatomic, assign) NSInteger rank;
+@end
+
+@implementation EZFormBenchmarkModel
+@end
+
+
+#pragma mark - Delegate
+
+@interface EZFormBenchmarkDelegate : NSObject <EZFormDelegate>
+@property (nonatomic, assign) NSUInteger updateCount;
+@end
+
+@implementation EZFormBenchmarkDelegate
+
+- (void)form:(EZForm *)form didUpdateValueForField:(EZFormField *)formField modelIsValid:(BOOL)isValid
+{
+    #pragma unused(form, formField, isValid)
+    self.updateCount++;
+}
+
+- (void)form:(EZForm *)form didUpdateValuesForFieldKeys:(NSArray *)keys modelIsValid:(BOOL)isValid
+{
+    #pragma unused(form, keys, isValid)
+    self.updateCount++;
+}
+
+@end
+
+
+#pragma mark - Helpers
+
+static NSString *
+EZFormBenchmarkKey(NSUInteger index)
+{
+    return [NSString stringWithFormat:@"field%lu", (unsigned long)index];
+}
+
+/* EZFormValidateEmailFormat() as it was before the single-pass scan,
+ * kept as the baseline for testEmailValidationBenchmarks.
+ */
+static BOOL
+EZFormBenchmarkValidateEmailFormatBaseline(NSString *value)
+{
+    if ([value length] < 5) {
+	return NO;
+    }
+    
+    NSRange range = [value rangeOfString:@"@"];
+    if (range.location == NSNotFound || range.location < 1 || range.location >= [value length]-1) {
+	return NO;
+    }
+    
+    NSRange range2 = [value rangeOfString:@"@" options:NSBackwardsSearch];
+    if (range2.location != range.location) {
+	return NO;
+    }
+    
+    NSString *domain = [value componentsSeparatedByString:@"@"][1];
+    if ([domain length] < 3) {
+	return NO;
+    }
+    
+    range = [domain rangeOfString:@"."];
+    if (range.location == NSNotFound || range.location < 1) {
+	return NO;
+    }
+    
+    range = [domain rangeOfString:@".."];
+    if (range.location != NSNotFound) {
+	return NO;
+    }
+    
+    return YES;
+}
+
+/* Replays choice index accesses against a least recently used cache of
+ * capacity pages of pageSize choices, returning the number of misses.
+ */
+static NSUInteger
+EZFormBenchmarkPageMisses(NSArray *indexes, NSUInteger pageSize, NSUInteger capacity)
+{
+    NSMutableOrderedSet *recentPageNumbers = [NSMutableOrderedSet orderedSet];
+    NSUInteger misses = 0;
+    for (NSNumber *index in indexes) {
+	NSNumber *pageNumber = @([index unsignedIntegerValue] / pageSize);
+	if ([recentPageNumbers containsObject:pageNumber]) {
+	    [recentPageNumbers removeObject:pageNumber];
+	}
+	else {
+	    misses++;
+	    if ([recentPageNumbers count] == capacity) {
+		[recentPageNumbers removeObjectAtIndex:0];
+	    }
+	}
+	[recentPageNumbers addObject:pageNumber];
+    }
+    return misses;
+}
+
+static NSString *
+EZFormBenchmarkString(NSUInteger length)
+{
+    NSString *line = @"The quick brown fox jumps over the lazy dog 0123456789.\n";
+    NSMutableString *string = [NSMutableString stringWithCapacity:length];
+    while ([string length] < length) {
+	[string appendString:line];
+    }
+    return [string substringToIndex:length];
+}
+
+
+#pragma mark - Allocation counting
+
+static pthread_t volatile EZFormBenchmarkCountedThread;	// the measuring thread, NULL when not measuring
+static int64_t EZFormBenchmarkAllocations;	// only changed by the counted thread
+static int64_t EZFormBenchmarkAllocatedBytes;
+static void *(*EZFormBenchmarkZoneMalloc)(malloc_zone_t *zone, size_t size);
+static void *(*EZFormBenchmarkZoneCalloc)(malloc_zone_t *zone, size_t count, size_t size);
+static void *(*EZFormBenchmarkZoneRealloc)(malloc_zone_t *zone, void *ptr, size_t size);
+
+static void *
+EZFormBenchmarkCountingMalloc(malloc_zone_t *zone, size_t size)
+{
+    if (pthread_equal(pthread_self(), EZFormBenchmarkCountedThread)) {
+	EZFormBenchmarkAllocations += 1;
+	EZFormBenchmarkAllocatedBytes += (int64_t)size;
+    }
+    return EZFormBenchmarkZoneMalloc(zone, size);
+}
+
+static void *
+EZFormBenchmarkCountingCalloc(malloc_zone_t *zone, size_t count, size_t size)
+{
+    if (pthread_equal(pthread_self(), EZFormBenchmarkCountedThread)) {
+	EZFormBenchmarkAllocations += 1;
+	EZFormBenchmarkAllocatedBytes += (int64_t)(count * size);
+    }
+    return EZFormBenchmarkZoneCalloc(zone, count, size);
+}
+
+static void *
+EZFormBenchmarkCountingRealloc(malloc_zone_t *zone, void *ptr, size_t size)
+{
+    if (pthread_equal(pthread_self(), EZFormBenchmarkCountedThread)) {
+	EZFormBenchmarkAllocations += 1;
+	EZFormBenchmarkAllocatedBytes += (int64_t)size;
+    }
+    return EZFormBenchmarkZoneRealloc(zone, ptr, size);
+}
+
+/* Counts the allocations made from the default malloc zone by the
+ * measuring thread, by wrapping the zone's allocation functions; other
+ * threads, such as the draft journal's queue, are not counted. Zone
+ * statistics only report the blocks still in use, which misses
+ * temporaries freed within a benchmark iteration. Returns NO, and logs
+ * why, if the zone could not be patched, in which case allocations are
+ * not reported.
+ */
+static BOOL
+EZFormBenchmarkInstallAllocationCounter(void)
+{
+    static BOOL installed = NO;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	malloc_zone_t *zone = malloc_default_zone();
+	
+	// The zone's function table is mapped read-only
+	kern_return_t result = vm_protect(mach_task_self(), (vm_address_t)zone, sizeof(malloc_zone_t), 0, VM_PROT_READ | VM_PROT_WRITE);
+	if (result != KERN_SUCCESS) {
+	    NSLog(@"EZFormBenchmarks: not counting allocations, the default malloc zone cannot be made writable: %s", mach_error_string(result));
+	    return;
+	}
+	EZFormBenchmarkZoneMalloc = zone->malloc;
+	EZFormBenchmarkZoneCalloc = zone->calloc;
+	EZFormBenchmarkZoneRealloc = zone->realloc;
+	zone->malloc = EZFormBenchmarkCountingMalloc;
+	zone->calloc = EZFormBenchmarkCountingCalloc;
+	zone->realloc = EZFormBenchmarkCountingRealloc;
+	vm_protect(mach_task_self(), (vm_address_t)zone, sizeof(malloc_zone_t), 0, VM_PROT_READ);
+	installed = YES;
+    });
+    return installed;
+}
+
+
+#pragma mark - EZFormBenchmarks
+
+@interface EZFormBenchmarks ()
+@property (nonatomic, strong) NSMutableArray *results;
+@property (nonatomic, assign) BOOL countsAllocations;
+@end
+
+@implementation EZFormBenchmarks
+
+- (void)setUp
+{
+    [super setUp];
+    
+    self.results = [NSMutableArray array];
+    self.countsAllocations = EZFormBenchmarkInstallAllocationCounter();
+}
+
+- (void)tearDown
+{
+    [self writeResults];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Recording
+
+- (NSArray *)fieldCounts
+{
+    NSUInteger maxFieldCount = 100000;
+    NSString *maxFieldCountString = [[NSProcessInfo processInfo] environment][@"EZFORM_BENCHMARK_MAX_FIELDS"];
+    if ([maxFieldCountString integerValue] > 0) {
+	maxFieldCount = (NSUInteger)[maxFieldCountString integerValue];
+    }
+    
+    NSMutableArray *fieldCounts = [NSMutableArray array];
+    for (NSUInteger count = 10; count <= maxFieldCount; count *= 10) {
+	[fieldCounts addObject:@(count)];
+    }
+    return fieldCounts;
+}
+
+- (void)measure:(NSString *)name n:(NSUInteger)n iterations:(NSUInteger)iterations block:(void (^)(NSUInteger iteration))block
+{
+    [self measure:name n:n iterations:iterations operationsPerIteration:1 block:block];
+}
+
+/* As measure:n:iterations:block:, for blocks performing several
+ * operations per call, so that per-operation figures are not dominated
+ * by the loop and autorelease pool around each call.
+ */
+- (void)measure:(NSString *)name n:(NSUInteger)n iterations:(NSUInteger)iterations operationsPerIteration:(NSUInteger)operationsPerIteration block:(void (^)(NSUInteger iteration))block
+{
+    int64_t startAllocations = EZFormBenchmarkAllocations;
+    int64_t startAllocatedBytes = EZFormBenchmarkAllocatedBytes;
+    EZFormBenchmarkCountedThread = pthread_self();
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i=0; i < iterations; i++) {
+	@autoreleasepool {
+	    block(i);
+	}
+    }
+    CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - start;
+    EZFormBenchmarkCountedThread = NULL;
+    int64_t allocations = EZFormBenchmarkAllocations - startAllocations;
+    int64_t allocatedBytes = EZFormBenchmarkAllocatedBytes - startAllocatedBytes;
+    double operations = (double)iterations * operationsPerIteration;
+    
+    NSMutableDictionary *result = [@{
+	@"benchmark": name,
+	@"n": @(n),
+	@"iterations": @(iterations),
+	@"total_ms": @(elapsed * 1000.0),
+	@"mean_us": @(elapsed * 1000000.0 / iterations),
+	@"ns_per_op": @(elapsed * 1000000000.0 / operations),
+    } mutableCopy];
+    if (self.countsAllocations) {
+	result[@"allocations_per_op"] = @((double)allocations / operations);
+	result[@"allocated_bytes_per_op"] = @((double)allocatedBytes / operations);
+    }
+    [self.results addObject:result];
+}
+
+- (void)writeResults
+{
+    if ([self.results count] == 0) return;
+    
+    NSString *path = [[NSProcessInfo processInfo] environment][@"EZFORM_BENCHMARK_OUTPUT"];
+    if ([path length] == 0) {
+	path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"EZFormBenchmarks.json"];
+    }
+    
+    NSDictionary *report = @{
+	@"suite": NSStringFromClass([self class]),
+	@"timestamp": @([[NSDate date] timeIntervalSince1970]),
+	@"results": self.results,
+    };
+    NSData *json = [NSJSONSerialization dataWithJSONObject:report options:NSJSONWritingPrettyPrinted error:NULL];
+    [json writeToFile:path atomically:YES];
+    
+    NSLog(@"EZFormBenchmarks: wrote %lu results to %@", (unsigned long)[self.results count], path);
+}
+
+
+#pragma mark - Fixtures
+
+/* Builds a form of n fields cycling through text, boolean, generic and
+ * radio fields. Every text field (index % 4 == 0) is wired to a mock label.
+ */
+- (EZForm *)formWithFieldCount:(NSUInteger)n delegate:(id<EZFormDelegate>)delegate
+{
+    EZForm *form = [[EZForm alloc] init];
+    form.delegate = delegate;
+    
+    NSArray *choices = @[@"a", @"b", @"c", @"d", @"e", @"f", @"g", @"h", @"i", @"j"];
+    
+    for (NSUInteger i=0; i < n; i++) {
+	NSString *key = EZFormBenchmarkKey(i);
+	EZFormField *field = nil;
+	
+	switch (i % 4) {
+	    case 0: {
+		EZFormTextField *textField = [[EZFormTextField alloc] initWithKey:key];
+		textField.validationMinCharacters = 3;
+		[textField useLabel:[[EZFormBenchmarkLabel alloc] initWithFrame:CGRectZero]];
+		textField.fieldValue = key;
+		field = textField;
+		break;
+	    }
+	    case 1: {
+		EZFormBooleanField *booleanField = [[EZFormBooleanField alloc] initWithKey:key];
+		booleanField.validationStates = EZFormBooleanFieldStateOn;
+		booleanField.fieldValue = @((i / 4) % 2 == 0);
+		field = booleanField;
+		break;
+	    }
+	    case 2: {
+		EZFormGenericField *genericField = [[EZFormGenericField alloc] initWithKey:key];
+		genericField.validationNotNil = YES;
+		genericField.fieldValue = @(i);
+		field = genericField;
+		break;
+	    }
+	    default: {
+		EZFormRadioField *radioField = [[EZFormRadioField alloc] initWithKey:key];
+		[radioField setChoicesFromArray:choices];
+		radioField.validationRestrictedToChoiceValues = YES;
+		radioField.fieldValue = choices[i % [choices count]];
+		field = radioField;
+		break;
+	    }
+	}
+	
+	[form addFormField:field];
+    }
+    
+    return form;
+}
+
+
+#pragma mark - Benchmarks
+
+- (void)testFormEngineBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	EZFormBenchmarkDelegate *delegate = [[EZFormBenchmarkDelegate alloc] init];
+	
+	__block EZForm *form = nil;
+	[self measure:@"form_build" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    form = [self formWithFieldCount:n delegate:delegate];
+	}];
+	
+	// A text field in the middle of the form
+	NSUInteger textFieldIndex = (n / 2) - (n / 2) % 4;
+	EZFormField *textField = [form formFieldForKey:EZFormBenchmarkKey(textFieldIndex)];
+	NSMutableString *typedText = [NSMutableString string];
+	delegate.updateCount = 0;
+	[self measure:@"keystroke_to_delegate" n:n iterations:100 block:^(__unused NSUInteger iteration) {
+	    [typedText appendString:@"x"];
+	    textField.fieldValue = typedText;
+	}];
+	STAssertEquals(delegate.updateCount, (NSUInteger)100, @"Expected one delegate update per keystroke");
+	
+	[self measure:@"is_form_valid_cold" n:n iterations:10 block:^(__unused NSUInteger iteration) {
+	    [form setNeedsValidation];
+	    [form isFormValid];
+	}];
+	
+	[self measure:@"is_form_valid_warm" n:n iterations:100 block:^(__unused NSUInteger iteration) {
+	    [form isFormValid];
+	}];
+	
+	[self measure:@"invalid_field_keys" n:n iterations:10 block:^(__unused NSUInteger iteration) {
+	    [form invalidFieldKeys];
+	}];
+	
+	[self measure:@"model_values" n:n iterations:10 block:^(__unused NSUInteger iteration) {
+	    [form modelValues];
+	}];
+	
+	NSDictionary *modelValues = [form modelValues];
+	[self measure:@"hydrate_set_model_value" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [modelValues enumerateKeysAndObjectsUsingBlock:^(id key, id value, __unused BOOL *stop) {
+		[form setModelValue:value forKey:key];
+	    }];
+	}];
+	
+	[self measure:@"hydrate_set_model_values" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [form setModelValues:modelValues];
+	}];
+	
+	// Radio field with n choices
+	NSMutableArray *choiceKeys = [NSMutableArray arrayWithCapacity:n];
+	NSMutableArray *choiceValues = [NSMutableArray arrayWithCapacity:n];
+	for (NSUInteger i=0; i < n; i++) {
+	    [choiceKeys addObject:EZFormBenchmarkKey(i)];
+	    [choiceValues addObject:[NSString stringWithFormat:@"Choice %lu", (unsigned long)i]];
+	}
+	EZFormRadioField *radioField = [[EZFormRadioField alloc] initWithKey:@"radio"];
+	radioField.validationRestrictedToChoiceValues = YES;
+	[self measure:@"radio_set_choices" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [radioField setChoicesFromKeys:choiceKeys values:choiceValues];
+	}];
+	
+	[self measure:@"radio_choice_lookup" n:n iterations:1000 block:^(NSUInteger iteration) {
+	    radioField.fieldValue = choiceKeys[(iteration * 7919) % n];
+	    [radioField fieldDisplayValue];
+	    [radioField isValid];
+	}];
+	
+	// Same choices fetched on demand from a data source with 1ms latency
+	EZFormBenchmarkSlowChoiceDataSource *dataSource = [[EZFormBenchmarkSlowChoiceDataSource alloc] init];
+	dataSource.store = radioField.choiceStore;
+	dataSource.latency = 1000;
+	EZFormRadioField *pagedRadioField = [[EZFormRadioField alloc] initWithKey:@"pagedRadio"];
+	[self measure:@"radio_data_source_open" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    pagedRadioField.choiceDataSource = dataSource;
+	    NSUInteger visibleRows = MIN([pagedRadioField numberOfChoices], (NSUInteger)20);
+	    for (NSUInteger row=0; row < visibleRows; row++) {
+		[pagedRadioField choiceValueAtIndex:row];
+	    }
+	}];
+	
+	[self measure:@"radio_data_source_scroll" n:n iterations:1000 block:^(NSUInteger iteration) {
+	    [pagedRadioField choiceValueAtIndex:(iteration * 13) % n];
+	}];
+	
+	// Exactly one fetch per page miss of the default page cache
+	NSMutableArray *accessedIndexes = [NSMutableArray array];
+	for (NSUInteger row=0; row < MIN(n, (NSUInteger)20); row++) {
+	    [accessedIndexes addObject:@(row)];
+	}
+	for (NSUInteger iteration=0; iteration < 1000; iteration++) {
+	    [accessedIndexes addObject:@((iteration * 13) % n)];
+	}
+	EZFormChoicePageCache *defaultPageCache = [[EZFormChoicePageCache alloc] initWithDataSource:nil];
+	NSUInteger expectedFetchCount = EZFormBenchmarkPageMisses(accessedIndexes, defaultPageCache.pageSize, defaultPageCache.capacity);
+	STAssertEquals(dataSource.fetchCount, expectedFetchCount, @"Expected one fetch per page miss");
+    }
+}
+
+- (void)testSnapshotBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	EZForm *form = [self formWithFieldCount:n delegate:nil];
+	EZFormField *textField = [form formFieldForKey:EZFormBenchmarkKey(0)];
+	
+	// Autosave check done by comparing whole model dictionaries
+	__block NSDictionary *previousModelValues = [form modelValues];
+	[self measure:@"change_check_model_values" n:n iterations:100 block:^(NSUInteger iteration) {
+	    textField.fieldValue = EZFormBenchmarkKey(iteration);
+	    NSDictionary *modelValues = [form modelValues];
+	    [modelValues isEqualToDictionary:previousModelValues];
+	    previousModelValues = modelValues;
+	}];
+	
+	__block EZFormSnapshot *previousSnapshot = nil;
+	[self measure:@"snapshot_first" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    previousSnapshot = [form modelSnapshot];
+	}];
+	
+	__block NSUInteger changedKeyCount = 0;
+	[self measure:@"change_check_snapshot" n:n iterations:100 block:^(NSUInteger iteration) {
+	    textField.fieldValue = EZFormBenchmarkKey(iteration + 1);
+	    EZFormSnapshot *snapshot = [form modelSnapshot];
+	    changedKeyCount += [[snapshot changesSince:previousSnapshot] count];
+	    previousSnapshot = snapshot;
+	}];
+	STAssertEquals(changedKeyCount, (NSUInteger)100, @"Expected one changed key per snapshot");
+	STAssertEqualObjects([previousSnapshot modelValues], [form modelValues], @"Expected snapshot to match form model values");
+    }
+}
+
+- (void)testDraftJournalBenchmarks
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"EZFormBenchmarks.journal"];
+    
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+	
+	NSError *error = nil;
+	EZFormDraftJournal *journal = [EZFormDraftJournal draftJournalWithPath:path error:&error];
+	STAssertNotNil(journal, @"Failed to open journal: %@", error);
+	
+	EZForm *form = [self formWithFieldCount:n delegate:nil];
+	form.draftJournal = journal;
+	
+	// A draft with every field edited once
+	[self measure:@"journal_append_all_fields" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    for (NSUInteger i=0; i < n; i += 4) {
+		[form setModelValue:[EZFormBenchmarkKey(i) stringByAppendingString:@"!"] forKey:EZFormBenchmarkKey(i)];
+	    }
+	    [journal synchronize];
+	}];
+	
+	// Typing at the end of a long text journals only the typed characters
+	EZFormField *textField = [form formFieldForKey:EZFormBenchmarkKey(0)];
+	NSMutableString *typedText = [EZFormBenchmarkString(100000) mutableCopy];
+	textField.fieldValue = typedText;
+	[journal synchronize];
+	unsigned long long sizeBefore = [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:NULL] fileSize];
+	[self measure:@"journal_keystroke" n:n iterations:100 block:^(__unused NSUInteger iteration) {
+	    [typedText appendString:@"x"];
+	    textField.fieldValue = typedText;
+	}];
+	[journal synchronize];
+	unsigned long long sizeAfter = [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:NULL] fileSize];
+	unsigned long long bytesPerKeystroke = (sizeAfter > sizeBefore ? (sizeAfter - sizeBefore) / 100 : 0);
+	[[self.results lastObject] setValue:@(bytesPerKeystroke) forKey:@"bytes_per_keystroke"];
+	STAssertTrue(bytesPerKeystroke < 64, @"Expected keystrokes to be journaled as edits, got %llu bytes per keystroke", bytesPerKeystroke);
+	form.draftJournal = nil;
+	journal = nil;
+	
+	EZForm *restoredForm = [self formWithFieldCount:n delegate:nil];
+	[self measure:@"journal_restore" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    EZFormDraftJournal *restoredJournal = [EZFormDraftJournal draftJournalWithPath:path error:NULL];
+	    [restoredJournal restoreForm:restoredForm];
+	}];
+	STAssertEqualObjects([restoredForm modelValues], [form modelValues], @"Expected restored form to match");
+    }
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+}
+
+- (void)testStateEncodingBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	EZForm *form = [self formWithFieldCount:n delegate:nil];
+	NSDictionary *modelValues = [form modelValues];
+	
+	__block NSData *jsonData = nil;
+	[self measure:@"state_encode_json" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    jsonData = [NSJSONSerialization dataWithJSONObject:modelValues options:0 error:NULL];
+	}];
+	[[self.results lastObject] setValue:@([jsonData length]) forKey:@"bytes"];
+	[self measure:@"state_decode_json" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:NULL];
+	}];
+	
+	__block NSData *archiveData = nil;
+	[self measure:@"state_encode_keyed_archiver" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    archiveData = [NSKeyedArchiver archivedDataWithRootObject:modelValues];
+	}];
+	[[self.results lastObject] setValue:@([archiveData length]) forKey:@"bytes"];
+	[self measure:@"state_decode_keyed_archiver" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [NSKeyedUnarchiver unarchiveObjectWithData:archiveData];
+	}];
+	
+	__block NSData *stateData = nil;
+	[self measure:@"state_encode_binary" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    stateData = [EZFormStateEncoder encodedDataWithForm:form];
+	}];
+	[[self.results lastObject] setValue:@([stateData length]) forKey:@"bytes"];
+	[self measure:@"state_decode_binary" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [[[EZFormStateDecoder alloc] initWithData:stateData error:NULL] modelValues];
+	}];
+	
+	// Lazy decode of a single field from a memory-mapped file
+	NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"EZFormBenchmarks.state"];
+	[stateData writeToFile:path atomically:YES];
+	[self measure:@"state_decode_binary_mapped_one_field" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [[EZFormStateDecoder decoderWithContentsOfFile:path error:NULL] modelValueForKey:EZFormBenchmarkKey(n / 2)];
+	}];
+	[[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+	
+	EZFormStateDecoder *decoder = [[EZFormStateDecoder alloc] initWithData:stateData error:NULL];
+	STAssertEqualObjects([decoder modelValues], modelValues, @"Expected decoded state to match");
+    }
+}
+
+- (void)testValidationDependencyBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	if (n < 16) continue;
+	EZForm *form = [self formWithFieldCount:n delegate:nil];
+	
+	__block NSUInteger validationCount = 0;
+	for (NSUInteger i=0; i < n; i++) {
+	    [[form formFieldForKey:EZFormBenchmarkKey(i)] addValidator:^BOOL(__unused id value) {
+		validationCount++;
+		return YES;
+	    }];
+	}
+	
+	// A short chain of cross-field rules hanging off the first field
+	[[form formFieldForKey:EZFormBenchmarkKey(4)] setValidationDependencyKeys:@[EZFormBenchmarkKey(0)]];
+	[[form formFieldForKey:EZFormBenchmarkKey(8)] setValidationDependencyKeys:@[EZFormBenchmarkKey(4)]];
+	[[form formFieldForKey:EZFormBenchmarkKey(12)] setValidationDependencyKeys:@[EZFormBenchmarkKey(0), EZFormBenchmarkKey(8)]];
+	EZFormField *textField = [form formFieldForKey:EZFormBenchmarkKey(0)];
+	[form isFormValid];
+	
+	validationCount = 0;
+	[self measure:@"dependency_revalidate_all" n:n iterations:100 block:^(NSUInteger iteration) {
+	    textField.fieldValue = EZFormBenchmarkKey(iteration);
+	    [form setNeedsValidation];
+	    [form isFormValid];
+	}];
+	[[self.results lastObject] setValue:@(validationCount / 100) forKey:@"validations_per_change"];
+	
+	validationCount = 0;
+	[self measure:@"dependency_revalidate_dependents" n:n iterations:100 block:^(NSUInteger iteration) {
+	    textField.fieldValue = EZFormBenchmarkKey(iteration + 1);
+	    [form isFormValid];
+	}];
+	[[self.results lastObject] setValue:@(validationCount / 100) forKey:@"validations_per_change"];
+	STAssertEquals(validationCount, (NSUInteger)400, @"Expected the changed field and its three dependents to be validated");
+    }
+}
+
+- (void)testComputedFieldBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	if (n < 16) continue;
+	EZForm *form = [self formWithFieldCount:n delegate:nil];
+	
+	// Generic fields (index % 4 == 2) hold numbers
+	NSArray *inputKeys = @[EZFormBenchmarkKey(2), EZFormBenchmarkKey(6), EZFormBenchmarkKey(10)];
+	__block NSUInteger computationCount = 0;
+	EZFormComputedField *totalField = [EZFormComputedField computedFieldWithKey:@"total" inputKeys:inputKeys computation:^id(NSDictionary *inputValues) {
+	    computationCount++;
+	    NSInteger total = 0;
+	    for (NSNumber *value in [inputValues allValues]) {
+		total += [value integerValue];
+	    }
+	    return @(total);
+	}];
+	EZFormComputedField *taxField = [EZFormComputedField computedFieldWithKey:@"tax" inputKeys:@[@"total"] computation:^id(NSDictionary *inputValues) {
+	    computationCount++;
+	    return @([inputValues[@"total"] doubleValue] * 0.1);
+	}];
+	[form addFormField:totalField];
+	[form addFormField:taxField];
+	EZFormField *inputField = [form formFieldForKey:EZFormBenchmarkKey(2)];
+	[form modelValues];
+	
+	computationCount = 0;
+	[self measure:@"computed_model_values_unchanged" n:n iterations:100 block:^(__unused NSUInteger iteration) {
+	    [form modelValues];
+	}];
+	[[self.results lastObject] setValue:@(computationCount) forKey:@"computations"];
+	STAssertEquals(computationCount, (NSUInteger)0, @"Expected remembered values to be reused");
+	
+	computationCount = 0;
+	[self measure:@"computed_value_after_input_change" n:n iterations:100 block:^(NSUInteger iteration) {
+	    inputField.fieldValue = @(iteration + n);
+	    [taxField modelValue];
+	}];
+	[[self.results lastObject] setValue:@(computationCount) forKey:@"computations"];
+	STAssertEquals(computationCount, (NSUInteger)200, @"Expected one computation of each computed field per change");
+    }
+}
+
+- (void)testCoalescedKeystrokeBenchmarks
+{
+    NSString *typedText = @"The quick brown fox jumps over the lazy dog";
+    
+    for (NSNumber *coalesces in @[@NO, @YES]) {
+	EZFormBenchmarkDelegate *delegate = [[EZFormBenchmarkDelegate alloc] init];
+	EZForm *form = [self formWithFieldCount:100 delegate:delegate];
+	form.coalescesValueChanges = [coalesces boolValue];
+	
+	__block NSUInteger validationCount = 0;
+	EZFormTextField *field = [form formFieldForKey:EZFormBenchmarkKey(0)];
+	[field addValidator:^BOOL(__unused id value) {
+	    validationCount++;
+	    return YES;
+	}];
+	EZFormBenchmarkTextField *textField = [[EZFormBenchmarkTextField alloc] initWithFrame:CGRectZero];
+	[field useTextField:textField];
+	field.invalidIndicatorView = [EZForm formInvalidIndicatorViewForType:EZFormInvalidIndicatorViewTypeTriangleExclamation size:CGSizeMake(20.0f, 20.0f)];
+	[form isFormValid];
+	
+	validationCount = 0;
+	delegate.updateCount = 0;
+	NSString *name = ([coalesces boolValue] ? @"keystroke_burst_coalesced" : @"keystroke_burst");
+	[self measure:name n:[typedText length] iterations:1 block:^(__unused NSUInteger iteration) {
+	    for (NSUInteger i=1; i <= [typedText length]; i++) {
+		textField.text = [typedText substringToIndex:i];
+		[field textFieldAllEditingEvents:textField];
+	    }
+	    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+	}];
+	[[self.results lastObject] setValue:@(validationCount) forKey:@"validations"];
+	[[self.results lastObject] setValue:@(delegate.updateCount) forKey:@"delegate_updates"];
+	
+	if ([coalesces boolValue]) {
+	    STAssertEquals(validationCount, (NSUInteger)1, @"Expected one validation for the burst");
+	    STAssertEquals(delegate.updateCount, (NSUInteger)1, @"Expected one delegate update for the burst");
+	}
+    }
+}
+
+- (void)testValidationReportBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	EZForm *form = [self formWithFieldCount:n delegate:nil];
+	
+	// Every other boolean field is off, failing its type-specific validation
+	__block EZFormValidationReport *report = nil;
+	[self measure:@"validation_report_first" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    [form setNeedsValidation];
+	    report = [form validationReport];
+	}];
+	[[self.results lastObject] setValue:@([report.invalidFieldKeys count]) forKey:@"invalid_fields"];
+	
+	__block NSUInteger reasonCount = 0;
+	[self measure:@"validation_report_cached" n:n iterations:100 block:^(__unused NSUInteger iteration) {
+	    EZFormValidationReport *cachedReport = [form validationReport];
+	    for (NSString *key in [form invalidFieldKeys]) {
+		if ([cachedReport failedReportForFieldKey:key].failureReason) reasonCount++;
+	    }
+	    STAssertTrue(cachedReport == report, @"Expected the cached report to be reused");
+	}];
+	STAssertEquals(reasonCount, [report.invalidFieldKeys count] * 100, @"Expected a failure reason for every invalid field");
+    }
+}
+
+- (void)testTemplateBenchmarks
+{
+    NSUInteger n = 1000;
+    NSMutableArray *countryKeys = [NSMutableArray arrayWithCapacity:250];
+    for (NSUInteger i=0; i < 250; i++) {
+	[countryKeys addObject:EZFormBenchmarkKey(i)];
+    }
+    
+    [self measure:@"form_construct_imperative" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	for (NSUInteger i=0; i < n; i++) {
+	    EZForm *form = [[EZForm alloc] init];
+	    EZFormTextField *nameField = [[EZFormTextField alloc] initWithKey:@"name"];
+	    nameField.validationRules = [EZFormValidationRules validationRulesWithSpec:@"required|min:2|max:64"];
+	    [form addFormField:nameField];
+	    EZFormTextField *emailField = [[EZFormTextField alloc] initWithKey:@"email"];
+	    [emailField addValidator:EZFormEmailAddressValidator];
+	    [emailField addInputFilter:EZFormEmailAddressInputFilter];
+	    [form addFormField:emailField];
+	    EZFormRadioField *countryField = [[EZFormRadioField alloc] initWithKey:@"country"];
+	    [countryField setChoicesFromArray:countryKeys];
+	    countryField.validationRequiresSelection = YES;
+	    [form addFormField:countryField];
+	    EZFormDateField *dateField = [[EZFormDateField alloc] initWithKey:@"birthday"];
+	    [form addFormField:dateField];
+	}
+    }];
+    
+    __block EZFormTemplate *formTemplate = nil;
+    [self measure:@"form_template_parse" n:1 iterations:1 block:^(__unused NSUInteger iteration) {
+	NSError *error = nil;
+	formTemplate = [EZFormTemplate templateWithSchema:@{@"fields": @[
+	    @{@"key": @"name", @"type": @"text", @"rules": @"required|min:2|max:64"},
+	    @{@"key": @"email", @"type": @"text", @"validator": @"email", @"inputFilter": @"email"},
+	    @{@"key": @"country", @"type": @"radio", @"choices": countryKeys, @"requiresSelection": @YES},
+	    @{@"key": @"birthday", @"type": @"date"},
+	]} error:&error];
+	STAssertNotNil(formTemplate, @"Template failed: %@", error);
+    }];
+    
+    [self measure:@"form_construct_template" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	for (NSUInteger i=0; i < n; i++) {
+	    [formTemplate instantiateForm];
+	}
+    }];
+}
+
+- (void)testTransformerCacheBenchmarks
+{
+    for (NSNumber *fieldCount in [self fieldCounts]) {
+	NSUInteger n = [fieldCount unsignedIntegerValue];
+	
+	// Generic fields holding strings, modelled as numbers
+	EZForm *form = [[EZForm alloc] init];
+	for (NSUInteger i=0; i < n; i++) {
+	    EZFormGenericField *field = [[EZFormGenericField alloc] initWithKey:EZFormBenchmarkKey(i)];
+	    field.valueTransformer = [EZFormReversibleValueTransformer reversibleValueTransformerWithForwardBlock:^id(id value) {
+		return [value description];
+	    } reverseBlock:^id(id value) {
+		return @([(NSString *)value integerValue]);
+	    }];
+	    [form addFormField:field];
+	    field.modelValue = @(i);
+	}
+	
+	EZFormInstrumentation *instrumentation = [[EZFormInstrumentation alloc] init];
+	form.instrumentation = instrumentation;
+	
+	[self measure:@"transformed_model_values" n:n iterations:10 block:^(__unused NSUInteger iteration) {
+	    [form modelValues];
+	}];
+	
+	NSString *fieldKey = EZFormBenchmarkKey(0);
+	NSUInteger hits = [instrumentation statisticsForEvent:EZFormInstrumentationEventReverseTransformedValueCacheHit fieldKey:fieldKey].count;
+	NSUInteger misses = [instrumentation statisticsForEvent:EZFormInstrumentationEventReverseTransformedValue fieldKey:fieldKey].count;
+	[[self.results lastObject] setValue:@((double)hits / (double)(hits + misses)) forKey:@"hit_rate"];
+	STAssertEquals(misses, (NSUInteger)1, @"Expected one reverse transformation per value change");
+    }
+}
+
+- (void)testKeyPathAccessorBenchmarks
+{
+    NSUInteger n = 100000;
+    EZFormBenchmarkModel *parent = [[EZFormBenchmarkModel alloc] init];
+    parent.name = @"Parent";
+    NSMutableArray *models = [NSMutableArray arrayWithCapacity:n];
+    for (NSUInteger i=0; i < n; i++) {
+	EZFormBenchmarkModel *model = [[EZFormBenchmarkModel alloc] init];
+	model.identifier = EZFormBenchmarkKey(i);
+	model.name = [NSString stringWithFormat:@"Model %lu", (unsigned long)i];
+	model.parent = parent;
+	model.rank = (NSInteger)i;
+	[models addObject:model];
+    }
+    
+    for (NSString *keyPath in @[@"identifier", @"rank", @"parent.name"]) {
+	NSString *suffix = [keyPath stringByReplacingOccurrencesOfString:@"." withString:@"_"];
+	
+	[self measure:[@"key_path_kvc_" stringByAppendingString:suffix] n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    for (EZFormBenchmarkModel *model in models) {
+		[model valueForKeyPath:keyPath];
+	    }
+	}];
+	
+	EZFormKeyPathAccessor *accessor = [EZFormKeyPathAccessor accessorWithKeyPath:keyPath];
+	[self measure:[@"key_path_accessor_" stringByAppendingString:suffix] n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	    for (EZFormBenchmarkModel *model in models) {
+		[accessor valueForObject:model];
+	    }
+	}];
+	
+	EZFormBenchmarkModel *model = models[n - 1];
+	STAssertEqualObjects([accessor valueForObject:model], [model valueForKeyPath:keyPath], @"Expected accessor to match valueForKeyPath:");
+    }
+    
+    EZFormValueTransformer *transformer = [EZFormValueTransformer valueTransformerWithKeyPathForValue:@"identifier" keyPathForDisplayValue:@"name"];
+    [self measure:@"key_path_transformer_choices" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	[transformer transformedValue:models];
+    }];
+}
+
+- (void)testChoiceSearchBenchmarks
+{
+    NSUInteger n = 250000;
+    NSArray *syllables = @[@"ber", @"lin", @"São", @"pau", @"lo", @"new", @"york", @"mün", @"chen", @"ville", @"port", @"Zü", @"rich"];
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:n];
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:n];
+    for (NSUInteger i=0; i < n; i++) {
+	NSUInteger count = [syllables count];
+	NSString *value = [NSString stringWithFormat:@"%@%@ %@%@ %lu", syllables[i % count], syllables[(i / count) % count], syllables[(i / 7) % count], syllables[(i / 11) % count], (unsigned long)i];
+	[keys addObject:EZFormBenchmarkKey(i)];
+	[values addObject:value];
+    }
+    
+    EZFormRadioField *field = [[EZFormRadioField alloc] initWithKey:@"city"];
+    [field setChoicesFromKeys:keys values:values];
+    
+    [self measure:@"choice_search_index_build" n:n iterations:1 block:^(__unused NSUInteger iteration) {
+	[field choiceKeysMatchingSearchString:@"x"];
+    }];
+    
+    // Short prefixes match the most choices and must still answer within a frame
+    double frameNanoseconds = 1000000000.0 / 60.0;
+    NSArray *typedPrefixes = @[@"m", @"mu", @"mun", @"munc", @"munch", @"munche", @"munchen", @"munchen z", @"munchen zu"];
+    for (NSString *searchString in typedPrefixes) {
+	__block NSUInteger resultCount = 0;
+	[self measure:[NSString stringWithFormat:@"choice_search_query[%@]", searchString] n:n iterations:10 block:^(__unused NSUInteger iteration) {
+	    resultCount = [[field choiceKeysMatchingSearchString:searchString] count];
+	}];
+	NSMutableDictionary *result = [self.results lastObject];
+	[result setValue:@(resultCount) forKey:@"results"];
+	if ([searchString length] <= 2) {
+	    double nanosecondsPerQuery = [result[@"ns_per_op"] doubleValue];
+	    STAssertTrue(nanosecondsPerQuery < frameNanoseconds, @"Expected a search for \"%@\" over %lu choices within a frame, took %.0f ns", searchString, (unsigned long)n, nanosecondsPerQuery);
+	}
+    }
+}
+
+- (void)testEmailValidationBenchmarks
+{
+    NSUInteger n = 1000000;
+    NSArray *formats = @[@"user#@example.com", @"first.last#@mail.example.org", @"user#", @"user#@@example.com", @"user#@example..com", @"@user#.com", @"user#@.example.com", @"u#@x.y"];
+    NSMutableArray *addresses = [NSMutableArray arrayWithCapacity:n];
+    for (NSUInteger i=0; i < n; i++) {
+	NSString *number = [NSString stringWithFormat:@"%lu", (unsigned long)i];
+	[addresses addObject:[formats[i % [formats count]] stringByReplacingOccurrencesOfString:@"#" withString:number]];
+    }
+    
+    NSUInteger mismatchCount = 0;
+    for (NSString *address in addresses) {
+	if (EZFormValidateEmailFormat(address) != EZFormBenchmarkValidateEmailFormatBaseline(address)) {
+	    mismatchCount++;
+	}
+    }
+    STAssertEquals(mismatchCount, (NSUInteger)0, @"Expected the same result as the baseline for every address");
+    
+    NSUInteger batchSize = 1000;
+    __block NSUInteger validCount = 0;
+    [self measure:@"email_validate_baseline" n:n iterations:n / batchSize operationsPerIteration:batchSize block:^(NSUInteger iteration) {
+	for (NSUInteger i=iteration * batchSize; i < (iteration + 1) * batchSize; i++) {
+	    if (EZFormBenchmarkValidateEmailFormatBaseline(addresses[i])) validCount++;
+	}
+    }];
+    
+    [self measure:@"email_validate" n:n iterations:n / batchSize operationsPerIteration:batchSize block:^(NSUInteger iteration) {
+	for (NSUInteger i=iteration * batchSize; i < (iteration + 1) * batchSize; i++) {
+	    if (EZFormValidateEmailFormat(addresses[i])) validCount++;
+	}
+    }];
+    STAssertEquals(validCount, 2 * (n / [formats count]) * 3, @"Expected three valid formats in every eight addresses");
+}
+
+- (void)testLargeTextBenchmarks
+{
+    for (NSNumber *textLength in @[@(100 * 1024), @(1024 * 1024), @(10 * 1024 * 1024)]) {
+	NSUInteger length = [textLength unsignedIntegerValue];
+	NSString *document = [EZFormBenchmarkString(length) stringByAppendingString:@"  \n"];
+	
+	EZFormTextField *field = [[EZFormTextField alloc] initWithKey:@"notes"];
+	field.validationMinCharacters = 1;
+	EZFormBenchmarkTextField *textField = [[EZFormBenchmarkTextField alloc] initWithFrame:CGRectZero];
+	
+	// Each keystroke hands the field a new string, as a text view does.
+	// Making it is the baseline the value path is measured against.
+	__block NSString *typedText = document;
+	[self measure:@"text_keystroke_new_text" n:length iterations:100 block:^(__unused NSUInteger iteration) {
+	    typedText = [typedText stringByAppendingString:@"x"];
+	}];
+	double newTextBytesPerKeystroke = [[self.results lastObject][@"allocated_bytes_per_op"] doubleValue];
+	
+	typedText = document;
+	[self measure:@"text_keystroke_value" n:length iterations:100 block:^(__unused NSUInteger iteration) {
+	    typedText = [typedText stringByAppendingString:@"x"];
+	    textField.text = typedText;
+	    [field textFieldAllEditingEvents:textField];
+	    [field modelValue];
+	    [field isValid];
+	}];
+	if (self.countsAllocations) {
+	    // Typing after the trailing whitespace leaves nothing to trim, so
+	    // reading and validating the value must not copy the text
+	    double valueBytesPerKeystroke = [[self.results lastObject][@"allocated_bytes_per_op"] doubleValue] - newTextBytesPerKeystroke;
+	    STAssertTrue(valueBytesPerKeystroke < length / 2, @"Expected no copy of the %lu character document on the value path, allocated %.0f bytes per keystroke", (unsigned long)length, valueBytesPerKeystroke);
+	}
+	
+	field.fieldValue = document;
+	textField.text = document;
+	NSRange endRange = NSMakeRange([document length], 0);
+	
+	[field addInputDeltaFilter:EZFormNumericInputDeltaFilter];
+	[self measure:@"text_keystroke_delta_filter" n:length iterations:100 block:^(__unused NSUInteger iteration) {
+	    [field textField:textField shouldChangeCharactersInRange:endRange replacementString:@"1"];
+	}];
+	if (self.countsAllocations) {
+	    // A delta filter only looks at the typed text, so a keystroke
+	    // must not copy the document
+	    double allocatedBytesPerKeystroke = [[self.results lastObject][@"allocated_bytes_per_op"] doubleValue];
+	    STAssertTrue(allocatedBytesPerKeystroke < length / 2, @"Expected no copy of the %lu character document per keystroke, allocated %.0f bytes", (unsigned long)length, allocatedBytesPerKeystroke);
+	}
+	
+	[field addInputFilter:^BOOL(id input) {
+	    return ([(NSString *)input length] > 0);
+	}];
+	[self measure:@"text_keystroke_whole_string_filter" n:length iterations:10 block:^(__unused NSUInteger iteration) {
+	    [field textField:textField shouldChangeCharactersInRange:endRange replacementString:@"1"];
+	}];
+    }
+}
+
+@end
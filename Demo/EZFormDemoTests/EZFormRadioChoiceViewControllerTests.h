@@ -0,0 +1,15 @@
+//
+//  EZFormRadioChoiceViewControllerTests.h
+//  EZFormDemoTests
+//
+//  Copyright (c) 2012-2013 Chris Miles. All rights reserved.
+//
+
+#import <SenTestingKit/SenTestingKit.h>
+
+/** Tests that the radio choice table stays consistent with the field's
+ *  choices while a search is active.
+ */
+@interface EZFormRadioChoiceViewControllerTests : SenTestCase
+
+@end
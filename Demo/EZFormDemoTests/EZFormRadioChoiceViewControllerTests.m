@@ -0,0 +1,143 @@
+//
+//  EZFormRadioChoiceViewControllerTests.m
+//  EZFormDemoTests
+//
+//  Copyright (c) 2012-2013 Chris Miles. All rights reserved.
+//
+
+#import "EZFormRadioChoiceViewControllerTests.h"
+#import <EZForm/EZForm.h>
+
+
+#pragma mark - Searchable data source
+
+/* A data source that searches its own choices, as a remote catalog would.
+ */
+@interface EZFormRadioChoiceTestDataSource : EZFormChoiceStore
+@end
+
+@implementation EZFormRadioChoiceTestDataSource
+
+- (NSArray *)choiceKeysMatchingSearchString:(NSString *)searchString
+{
+    NSMutableArray *keys = [NSMutableArray array];
+    for (id key in [self allKeys]) {
+	if ([[self choiceValueForKey:key] rangeOfString:searchString options:NSCaseInsensitiveSearch].location != NSNotFound) {
+	    [keys addObject:key];
+	}
+    }
+    return keys;
+}
+
+@end
+
+
+#pragma mark - Tests
+
+@interface EZFormRadioChoiceViewControllerTests ()
+@property (nonatomic, strong) EZForm *form;
+@property (nonatomic, strong) EZFormRadioField *radioField;
+@property (nonatomic, strong) EZFormRadioChoiceViewController *choiceViewController;
+@end
+
+@implementation EZFormRadioChoiceViewControllerTests
+
+- (void)setUp
+{
+    [super setUp];
+    
+    NSMutableArray *choices = [NSMutableArray array];
+    for (NSUInteger i=0; i < 100; i++) {
+	[choices addObject:[NSString stringWithFormat:@"Item %lu", (unsigned long)i]];
+    }
+    
+    self.form = [[EZForm alloc] init];
+    self.radioField = [[EZFormRadioField alloc] initWithKey:@"choice"];
+    [self.radioField setChoicesFromArray:choices];
+    [self.form addFormField:self.radioField];
+    
+    self.choiceViewController = [[EZFormRadioChoiceViewController alloc] initWithStyle:UITableViewStylePlain];
+    self.choiceViewController.form = self.form;
+    self.choiceViewController.radioFieldKey = @"choice";
+    self.choiceViewController.showsSearchBar = YES;
+    [self.choiceViewController view];
+}
+
+- (void)tearDown
+{
+    self.choiceViewController = nil;
+    self.radioField = nil;
+    self.form = nil;
+    
+    [super tearDown];
+}
+
+- (void)search:(NSString *)searchText
+{
+    [(id<UISearchBarDelegate>)self.choiceViewController searchBar:nil textDidChange:searchText];
+}
+
+- (NSInteger)numberOfRows
+{
+    UITableView *tableView = self.choiceViewController.tableView;
+    return [self.choiceViewController tableView:tableView numberOfRowsInSection:0];
+}
+
+/* Configures every row the table reports, as the table view would.
+ */
+- (NSArray *)rowTitles
+{
+    UITableView *tableView = self.choiceViewController.tableView;
+    NSMutableArray *titles = [NSMutableArray array];
+    for (NSInteger row=0; row < [self numberOfRows]; row++) {
+	UITableViewCell *cell = [self.choiceViewController tableView:tableView cellForRowAtIndexPath:[NSIndexPath indexPathForRow:row inSection:0]];
+	[titles addObject:cell.textLabel.text];
+    }
+    return titles;
+}
+
+- (void)testShrinkingChoicesDuringSearch
+{
+    [self search:@"Item"];
+    STAssertEquals([self numberOfRows], (NSInteger)100, @"Expected every choice to match");
+    
+    [self.radioField setChoicesFromArray:@[@"Item 0", @"Other", @"Item 1"]];
+    STAssertEquals([self numberOfRows], (NSInteger)2, @"Expected the search to run again over the new choices");
+    
+    NSArray *expectedTitles = @[@"Item 0", @"Item 1"];
+    STAssertEqualObjects([self rowTitles], expectedTitles, @"Expected rows of the new choices only");
+}
+
+- (void)testReplacingDataSourceDuringSearch
+{
+    [self search:@"Item 9"];
+    STAssertEquals([self numberOfRows], (NSInteger)11, @"Expected Item 9 and Item 90-99 to match");
+    
+    self.radioField.choiceDataSource = [[EZFormRadioChoiceTestDataSource alloc] initWithKeys:@[@"Item 9"] values:@[@"Item 9"]];
+    STAssertEquals([self numberOfRows], (NSInteger)1, @"Expected the search to run again over the data source");
+    
+    NSArray *expectedTitles = @[@"Item 9"];
+    STAssertEqualObjects([self rowTitles], expectedTitles, @"Expected rows of the data source only");
+}
+
+- (void)testAddingChoicesDuringSearch
+{
+    [self search:@"New"];
+    STAssertEquals([self numberOfRows], (NSInteger)0, @"Expected no choice to match");
+    
+    [self.radioField.choiceStore addChoicesWithKeys:@[@"New 0", @"New 1"] values:@[@"New 0", @"New 1"]];
+    NSArray *expectedTitles = @[@"New 0", @"New 1"];
+    STAssertEqualObjects([self rowTitles], expectedTitles, @"Expected the added choices to match");
+}
+
+- (void)testClearingSearchAfterShrinkingChoices
+{
+    [self search:@"Item"];
+    [self.radioField setChoicesFromArray:@[@"Item 0"]];
+    [self search:@""];
+    
+    NSArray *expectedTitles = @[@"Item 0"];
+    STAssertEqualObjects([self rowTitles], expectedTitles, @"Expected every remaining choice");
+}
+
+@end
@@ -30,6 +30,16 @@
 - (void)formFieldInputDidEnd:(EZFormField *)formField;
 - (void)formFieldDidBeginEditing:(EZFormField *)formField;
 - (void)formFieldDidChangeValue:(EZFormField *)formField;
+- (void)formFieldDidChangeModelValue:(EZFormField *)formField;
+- (void)formFieldNeedsValidation:(EZFormField *)formField;
+- (void)formField:(EZFormField *)formField willChangeValidationDependencyKeys:(NSArray *)keys;
+- (void)formField:(EZFormField *)formField willChangeKey:(NSString *)key;
+- (void)formFieldDidChangeKey:(EZFormField *)formField;
+- (void)formField:(EZFormField *)formField didResolveValidity:(BOOL)isValid;
+- (void)formFieldDidBeginPendingValidation:(EZFormField *)formField;
+- (void)formFieldDidResolvePendingValidation:(EZFormField *)formField;
+- (BOOL)deferViewUpdateForFormField:(EZFormField *)formField;
+- (BOOL)deferValidityIndicatorUpdateForFormField:(EZFormField *)formField;
 
 @end
 
@@ -39,6 +39,7 @@
 #import "EZFormBooleanField.h"
 #import "EZFormContinuousField.h"
 #import "EZFormGenericField.h"
+#import "EZFormComputedField.h"
 #import "EZFormRadioField.h"
 #import "EZFormMultiRadioFormField.h"
 #import "EZFormDateField.h"
@@ -49,6 +50,15 @@
 #import "EZFormInputControl.h"
 #import "EZFormValueTransformer.h"
 #import "EZFormReversibleValueTransformer.h"
+#import "EZFormKeyPathAccessor.h"
+#import "EZFormAsyncValidator.h"
+#import "EZFormValidationRules.h"
+#import "EZFormInstrumentation.h"
+#import "EZFormSnapshot.h"
+#import "EZFormDraftJournal.h"
+#import "EZFormStateCoder.h"
+#import "EZFormTemplate.h"
+#import "EZFormValidationReport.h"
 
 
 typedef NS_ENUM(NSInteger, EZFormInputAccessoryType) {
@@ -135,12 +145,74 @@ typedef NS_ENUM(NSInteger, EZFormInvalidIndicatorViewType) {
  */
 @property (nonatomic, assign) CGRect autoScrollForKeyboardInputVisibleRect;
 
+/** Records timing statistics for the form and its fields.
+ *
+ *  When set, the form records call counts and latencies of field
+ *  validation (per validator), value transformer calls, view updates
+ *  and value related delegate callbacks. See EZFormInstrumentation.
+ *
+ *  Default is nil (instrumentation disabled).
+ */
+@property (nonatomic, strong) EZFormInstrumentation *instrumentation;
+
+/** Journals field value changes for crash-safe autosave.
+ *
+ *  When set, the new model value of every changed field is appended to
+ *  the journal as it changes, including changes made between beginUpdates
+ *  and endUpdates. Use -[EZFormDraftJournal restoreForm:] to restore a
+ *  draft on launch. See EZFormDraftJournal.
+ *
+ *  Default is nil (no journal).
+ */
+@property (nonatomic, strong) EZFormDraftJournal *draftJournal;
+
+/** Handles bursts of field value changes, such as fast typing or
+ *  pasting, as one batch.
+ *
+ *  When YES, the first value change opens an implicit beginUpdates
+ *  batch. The batch ends after valueChangeCoalescingInterval. Values
+ *  are stored immediately. Validity indicators, view refreshes, form
+ *  validation and delegate messages are put off until the batch ends
+ *  and are then done once, as described for endUpdates.
+ *
+ *  Setting this to NO ends an open batch straight away.
+ *
+ *  Default is NO.
+ */
+@property (nonatomic, assign) BOOL coalescesValueChanges;
+
+/** How long a batch of coalesced value changes stays open, in seconds.
+ *
+ *  Zero ends the batch on the next turn of the main run loop.
+ *
+ *  Default is 0.
+ */
+@property (nonatomic, assign) NSTimeInterval valueChangeCoalescingInterval;
+
 /** Adds a field to the form.
+ *
+ *  Fields are indexed by key. Changing the key of a field already in
+ *  the form re-indexes it, and raises an exception if the new key
+ *  closes a cycle of validation dependencies.
  *
  *  @param formField The form field to add to the form.
  */
 - (void)addFormField:(EZFormField *)formField;
 
+/** Removes a field from the form.
+ *
+ *  Does nothing if the field is not part of the form.
+ *
+ *  @param formField The form field to remove from the form.
+ */
+- (void)removeFormField:(EZFormField *)formField;
+
+/** Removes the field with the specified key from the form.
+ *
+ *  @param key The key of the form field to remove.
+ */
+- (void)removeFormFieldForKey:(NSString *)key;
+
 /** Returns the form field object for the key specified.
  *
  *  @param key The key of the form field to return.
@@ -155,6 +227,9 @@ typedef NS_ENUM(NSInteger, EZFormInvalidIndicatorViewType) {
  *  Only returns YES if all form field values pass their validation rules.
  *  Otherwise, returns NO.
  *
+ *  Validation results are cached per field, so only fields whose value or
+ *  validation rules changed since they were last validated are revalidated.
+ *
  *  @returns A boolean indicating whether all field values of the form are valid.
  */
 @property (nonatomic, getter=isFormValid, readonly) BOOL formValid;
@@ -176,6 +251,25 @@ typedef NS_ENUM(NSInteger, EZFormInvalidIndicatorViewType) {
  */
 @property (nonatomic, readonly, copy) NSArray *invalidFieldKeys;
 
+/** Returns a report of the validation of the whole form.
+ *
+ *  The report lists the fields that did not pass validation, each with
+ *  its EZFormFieldValidationReport recording which validation step
+ *  failed. Fields needing validation are validated first. The report is
+ *  cached until a field needs revalidating, so invalidFieldKeys, error
+ *  message views and the like can all read the same result.
+ */
+@property (nonatomic, readonly, strong) EZFormValidationReport *validationReport;
+
+/** Discards the cached validation results of all fields.
+ *
+ *  Call this when state that validators depend on, other than the
+ *  field values, has changed.
+ *
+ *  Also see -[EZFormField setNeedsValidation].
+ */
+- (void)setNeedsValidation;
+
 /** Returns the current value of the specified field.
  *
  *  @param key The key of the field whose value to return.
@@ -190,6 +284,21 @@ typedef NS_ENUM(NSInteger, EZFormInvalidIndicatorViewType) {
  */
 @property (nonatomic, readonly, copy) NSDictionary *modelValues;
 
+/** Returns an immutable snapshot of all field model values.
+ *
+ *  The form tracks which fields changed since the last snapshot, so
+ *  taking a snapshot only reads the model values of those fields, and
+ *  returns the previous snapshot if nothing changed. Use
+ *  -[EZFormSnapshot changesSince:] to find the fields changed between
+ *  two snapshots, for example to autosave only what was edited.
+ *
+ *  If more than one field shares a key, the snapshot holds the value of
+ *  the field returned by formFieldForKey:.
+ *
+ *  @returns A snapshot of the form model.
+ */
+- (EZFormSnapshot *)modelSnapshot;
+
 /** Set the value of the specified field.
  *
  *  @param value The new value of the field.
@@ -198,6 +307,45 @@ typedef NS_ENUM(NSInteger, EZFormInvalidIndicatorViewType) {
  */
 - (void)setModelValue:(id)value forKey:(NSString *)key;
 
+/** Set the values of several fields at once.
+ *
+ *  The values are set inside a beginUpdates/endUpdates pair, so views are
+ *  refreshed, the form is validated and the delegate is notified only
+ *  once, after all values have been set. The updates are ended even if
+ *  setting a value raises an exception.
+ *
+ *  Keys that do not match a field of the form are ignored.
+ *
+ *  @param modelValues A dictionary of new model values, keyed by field key.
+ */
+- (void)setModelValues:(NSDictionary *)modelValues;
+
+/** Begins a series of field value changes that should be handled as one.
+ *
+ *  Until the matching endUpdates, changes to field values are stored
+ *  immediately but wired views and their validity indicators are not
+ *  refreshed, the form is not validated and the delegate is not
+ *  notified.
+ *
+ *  Calls to beginUpdates and endUpdates can be nested.
+ */
+- (void)beginUpdates;
+
+/** Ends a series of field value changes started by beginUpdates.
+ *
+ *  When the outermost update ends, the views of all changed fields are
+ *  refreshed and the form is validated once. The delegate then receives
+ *  a single form:didUpdateValuesForFieldKeys:modelIsValid: message
+ *  listing the changed fields. Delegates that only implement
+ *  form:didUpdateValueForField:modelIsValid: receive that message once per
+ *  changed field instead, all with the same validity result.
+ */
+- (void)endUpdates;
+
+/** Whether the form is between beginUpdates and endUpdates.
+ */
+@property (nonatomic, getter=isUpdating, readonly) BOOL updating;
+
 /** Notifies the receiver to request all of its field controls to resign first responder.
  *
  *  All wired up user interface controls will be notified to resign first
@@ -291,6 +439,46 @@ typedef NS_ENUM(NSInteger, EZFormInvalidIndicatorViewType) {
  */
 - (void)form:(EZForm *)form didUpdateValueForField:(EZFormField *)formField modelIsValid:(BOOL)isValid;
 
+/** Tells the delegate that field values were updated by a batch of changes.
+ *
+ *  Sent once at the end of a beginUpdates/endUpdates pair, or after
+ *  setModelValues:, instead of one form:didUpdateValueForField:modelIsValid:
+ *  message per changed field.
+ *
+ *  @param form The form for which field values were updated.
+ *
+ *  @param keys The keys of the updated fields, in the order they were first changed.
+ *
+ *  @param isValid Whether the form model is valid or not.
+ */
+- (void)form:(EZForm *)form didUpdateValuesForFieldKeys:(NSArray *)keys modelIsValid:(BOOL)isValid;
+
+/** Tells the delegate that asynchronous validation of a field has started.
+ *
+ *  Until validation is resolved the field, and so the form, is treated
+ *  as invalid.
+ *
+ *  Also see -[EZFormField addAsyncValidator:].
+ *
+ *  @param form The form containing the field.
+ *
+ *  @param formField The form field being validated.
+ */
+- (void)form:(EZForm *)form didBeginPendingValidationForField:(EZFormField *)formField;
+
+/** Tells the delegate that asynchronous validation of a field has finished.
+ *
+ *  Not sent if the field value changed while validation was in progress.
+ *  Use -[EZFormField isValid] to find out the result for the field.
+ *
+ *  @param form The form containing the field.
+ *
+ *  @param formField The form field that was validated.
+ *
+ *  @param isValid Whether the form model is valid or not.
+ */
+- (void)form:(EZForm *)form didResolvePendingValidationForField:(EZFormField *)formField modelIsValid:(BOOL)isValid;
+
 /** Tells the delegate that the user finished form input on the last field.
  *
  *  This is normally called when the user hits the return key on the last
@@ -25,10 +25,30 @@
 #import "EZForm.h"
 #import "EZForm+Private.h"
 #import "EZFormField+Private.h"
+#import "EZFormInstrumentation+Private.h"
 #import "EZFormStandardInputAccessoryView.h"
 #import "EZFormInvalidIndicatorTriangleExclamationView.h"
 #import "UIView+EZFormUtility.h"
 
+#pragma mark - External Class Categories
+
+@interface EZFormSnapshot (EZFormPrivateAccess)
++ (instancetype)snapshotWithParent:(EZFormSnapshot *)parent form:(EZForm *)form changedKeys:(id<NSFastEnumeration>)changedKeys version:(NSUInteger)version lineage:(id)lineage;
+@end
+
+@interface EZFormComputedField (EZFormPrivateAccess)
+- (void)inputValuesDidChange;
+@end
+
+@interface EZFormValidationReport (EZFormPrivateAccess)
+- (instancetype)initWithFailedFieldReports:(NSArray *)failedFieldReports;
+@end
+
+@interface EZFormTextField (EZFormPrivateAccess)
+- (void)updateValidityIndicators;
+@end
+
+
 #pragma mark - EZForm class extension
 
 @interface EZForm () {
@@ -38,11 +58,27 @@
     NSTimeInterval _keyboardAnimationDuration;
     BOOL _resigningFirstResponder;
     BOOL _scrollViewInsetsWereSaved;
+    NSUInteger _updatesNestingLevel;
     CGRect _visibleKeyboardFrame;
+    NSUInteger _modelVersion;
+    BOOL _coalescingValueChanges;
+    NSUInteger _nextFormFieldOrdinal;
 }
 
 @property (nonatomic, strong)	NSMutableArray		*formFields;
+@property (nonatomic, strong)	NSMutableDictionary	*formFieldsByKey;
+@property (nonatomic, strong)	NSMapTable		*formFieldOrdinals;	// field -> position key, increasing with index but with gaps
+@property (nonatomic, strong)	NSMutableOrderedSet	*formFieldsNeedingValidation;
+@property (nonatomic, strong)	NSMutableSet		*invalidFormFields;
+@property (nonatomic, strong)	EZFormValidationReport	*cachedValidationReport;	// nil when stale
+@property (nonatomic, strong)	NSMutableOrderedSet	*formFieldsChangedDuringUpdates;
+@property (nonatomic, strong)	NSMutableOrderedSet	*formFieldsNeedingViewUpdate;
+@property (nonatomic, strong)	NSMutableOrderedSet	*formFieldsNeedingValidityIndicatorUpdate;
 @property (nonatomic, strong)	UIView			*viewToAutoScroll;
+@property (nonatomic, strong)	EZFormSnapshot		*lastModelSnapshot;
+@property (nonatomic, strong)	NSMutableSet		*formFieldKeysChangedSinceSnapshot;
+@property (nonatomic, strong)	id			snapshotLineage;
+@property (nonatomic, strong)	NSMutableDictionary	*validationDependentsByKey;
 
 - (void)configureInputAccessoryForFormField:(EZFormField *)formField;
 - (void)updateInputAccessoryForEditingFormField:(EZFormField *)formField;
@@ -68,64 +104,122 @@
 
 - (void)addFormField:(EZFormField *)formField
 {
-    if (![self.formFields containsObject:formField]) {
+    if (nil == [self.formFieldOrdinals objectForKey:formField]) {
+	NSArray *validationDependencyKeys = formField.validationDependencyKeys;
+	if ([validationDependencyKeys count] > 0) {
+	    [self addValidationDependencyKeys:validationDependencyKeys forFormField:formField];
+	    if (nil == [self validationDependentsOfFormField:formField]) {
+		[self removeValidationDependencyKeys:validationDependencyKeys forFormField:formField];
+		[self raiseValidationDependencyCycleExceptionForFormField:formField];
+	    }
+	}
+	
+	[self.formFieldOrdinals setObject:@(_nextFormFieldOrdinal++) forKey:formField];
 	[self.formFields addObject:formField];
+	[self indexFormField:formField forKey:formField.key];
+	
 	formField.form = self;
+	[formField setNeedsValidation];
+	[self formFieldDidChangeModelValue:formField];
 	
 	[self configureInputAccessoryForFormField:formField];
     }
 }
 
-- (id)formFieldForKey:(NSString *)key
+- (void)removeFormField:(EZFormField *)formField
 {
-    EZFormField *result = nil;
-    for (EZFormField *formField in self.formFields) {
-	if ([formField.key isEqualToString:key]) {
-	    result = formField;
-	    break;
-	}
+    NSUInteger index = [self indexOfFormField:formField];
+    if (index == NSNotFound) {
+	return;
+    }
+    
+    [self.formFields removeObjectAtIndex:index];
+    [self.formFieldOrdinals removeObjectForKey:formField];
+    [self renumberFormFieldOrdinalsIfSparse];
+    
+    NSString *key = formField.key;
+    [self unindexFormField:formField forKey:key];
+    
+    [self.formFieldsNeedingValidation removeObject:formField];
+    [self.invalidFormFields removeObject:formField];
+    self.cachedValidationReport = nil;
+    
+    // Drop any work deferred for the field by an open batch of updates
+    [self.formFieldsChangedDuringUpdates removeObject:formField];
+    [self.formFieldsNeedingViewUpdate removeObject:formField];
+    [self.formFieldsNeedingValidityIndicatorUpdate removeObject:formField];
+    
+    [self removeValidationDependencyKeys:formField.validationDependencyKeys forFormField:formField];
+    [self setNeedsValidationOfDependentsOfFormField:formField];
+    
+    if (key) {
+	[self.formFieldKeysChangedSinceSnapshot addObject:key];
+	_modelVersion++;
     }
+    
+    formField.form = nil;
+}
 
-    return result;
+- (void)removeFormFieldForKey:(NSString *)key
+{
+    EZFormField *formField = [self formFieldForKey:key];
+    if (formField) {
+	[self removeFormField:formField];
+    }
 }
 
-- (BOOL)isFormValid
+- (id)formFieldForKey:(NSString *)key
 {
-    BOOL result = YES;
-    for (EZFormField *formField in self.formFields) {
-	if (![formField isValid]) {
-	    result = NO;
-	    break;
-	}
+    if (nil == key) {
+	return nil;
     }
-    return result;
+    
+    return self.formFieldsByKey[key];
+}
+
+- (BOOL)isFormValid
+{
+    [self validateFormFieldsNeedingValidation];
+    return ([self.invalidFormFields count] == 0);
 }
 
 - (BOOL)isFieldValid:(NSString *)key
 {
-    BOOL result = NO;
+    EZFormField *formField = [self formFieldForKey:key];
+    return [formField isValid];
+}
+
+- (NSArray *)invalidFieldKeys
+{
+    return self.validationReport.invalidFieldKeys;
+}
+
+- (EZFormValidationReport *)validationReport
+{
+    [self validateFormFieldsNeedingValidation];
     
-    for (EZFormField *formField in self.formFields) {
-	if ([formField.key isEqualToString:key]) {
-	    result = [formField isValid];
-	    break;
+    if (nil == self.cachedValidationReport) {
+	NSArray *invalidFormFields = [[self.invalidFormFields allObjects] sortedArrayUsingComparator:^NSComparisonResult(id formField1, id formField2) {
+	    NSNumber *ordinal1 = [self.formFieldOrdinals objectForKey:formField1];
+	    NSNumber *ordinal2 = [self.formFieldOrdinals objectForKey:formField2];
+	    return [ordinal1 compare:ordinal2];
+	}];
+	
+	NSMutableArray *failedFieldReports = [NSMutableArray arrayWithCapacity:[invalidFormFields count]];
+	for (EZFormField *formField in invalidFormFields) {
+	    [failedFieldReports addObject:formField.validationReport];
 	}
+	self.cachedValidationReport = [[EZFormValidationReport alloc] initWithFailedFieldReports:failedFieldReports];
     }
     
-    return result;
+    return self.cachedValidationReport;
 }
 
-- (NSArray *)invalidFieldKeys
+- (void)setNeedsValidation
 {
-    NSMutableArray *keys = [NSMutableArray array];
-    
     for (EZFormField *formField in self.formFields) {
-	if (![formField isValid]) {
-	    [keys addObject:[formField key]];
-	}
+	[formField setNeedsValidation];
     }
-    
-    return keys;
 }
 
 - (id)modelValueForKey:(NSString *)key
@@ -136,12 +230,67 @@
 
 - (void)setModelValue:(id)value forKey:(NSString *)key
 {
-    for (EZFormField *formField in self.formFields) {
-	if ([formField.key isEqualToString:key]) {
-		formField.modelValue = value;
-	    break;
+    EZFormField *formField = [self formFieldForKey:key];
+    formField.modelValue = value;
+}
+
+- (void)setModelValues:(NSDictionary *)modelValues
+{
+    // A raising transformer or validator must not leave the form batching
+    [self beginUpdates];
+    @try {
+	[modelValues enumerateKeysAndObjectsUsingBlock:^(id key, id value, __unused BOOL *stop) {
+	    [self setModelValue:value forKey:key];
+	}];
+    }
+    @finally {
+	[self endUpdates];
+    }
+}
+
+- (void)beginUpdates
+{
+    _updatesNestingLevel++;
+}
+
+- (void)endUpdates
+{
+    if (_updatesNestingLevel == 0) {
+	NSException *exception = [NSException exceptionWithName:@"Unbalanced endUpdates" reason:@"endUpdates called without a matching beginUpdates" userInfo:nil];
+	@throw exception;
+    }
+    
+    _updatesNestingLevel--;
+    if (_updatesNestingLevel > 0) {
+	return;
+    }
+    
+    NSArray *formFieldsNeedingViewUpdate = [self.formFieldsNeedingViewUpdate array];
+    [self.formFieldsNeedingViewUpdate removeAllObjects];
+    for (EZFormField *formField in formFieldsNeedingViewUpdate) {
+	if ([(id<EZFormFieldConcrete>)formField respondsToSelector:@selector(updateView)]) {
+	    [formField performUpdateView];
 	}
     }
+    
+    // Refreshed views have already updated their validity indicators
+    [self.formFieldsNeedingValidityIndicatorUpdate removeObjectsInArray:formFieldsNeedingViewUpdate];
+    NSArray *formFieldsNeedingValidityIndicatorUpdate = [self.formFieldsNeedingValidityIndicatorUpdate array];
+    [self.formFieldsNeedingValidityIndicatorUpdate removeAllObjects];
+    for (EZFormTextField *formField in formFieldsNeedingValidityIndicatorUpdate) {
+	[formField updateValidityIndicators];
+    }
+    
+    NSArray *changedFormFields = [self.formFieldsChangedDuringUpdates array];
+    [self.formFieldsChangedDuringUpdates removeAllObjects];
+    if ([changedFormFields count] > 0) {
+	[self notifyDelegateOfChangedFormFields:changedFormFields];
+    }
+}
+
+- (BOOL)isUpdating
+{
+    return (_updatesNestingLevel > 0);
 }
 
 - (NSDictionary *)modelValues
@@ -153,6 +302,15 @@
     return result;
 }
 
+- (EZFormSnapshot *)modelSnapshot
+{
+    if (nil == self.lastModelSnapshot || [self.formFieldKeysChangedSinceSnapshot count] > 0) {
+	self.lastModelSnapshot = [EZFormSnapshot snapshotWithParent:self.lastModelSnapshot form:self changedKeys:self.formFieldKeysChangedSinceSnapshot version:_modelVersion lineage:self.snapshotLineage];
+	[self.formFieldKeysChangedSinceSnapshot removeAllObjects];
+    }
+    return self.lastModelSnapshot;
+}
+
 - (void)resignFirstResponder
 {
     _resigningFirstResponder = YES;
@@ -193,12 +351,192 @@
 
 #pragma mark - Private Methods
 
+- (void)formFieldNeedsValidation:(EZFormField *)formField
+{
+    if ([self.formFieldOrdinals objectForKey:formField]) {
+	[self.formFieldsNeedingValidation addObject:formField];
+	self.cachedValidationReport = nil;
+    }
+}
+
+- (void)formField:(EZFormField *)formField willChangeValidationDependencyKeys:(NSArray *)keys
+{
+    if (nil == [self.formFieldOrdinals objectForKey:formField]) {
+	return;
+    }
+    
+    NSArray *previousKeys = formField.validationDependencyKeys;
+    [self removeValidationDependencyKeys:previousKeys forFormField:formField];
+    [self addValidationDependencyKeys:keys forFormField:formField];
+    if (nil == [self validationDependentsOfFormField:formField]) {
+	[self removeValidationDependencyKeys:keys forFormField:formField];
+	[self addValidationDependencyKeys:previousKeys forFormField:formField];
+	[self raiseValidationDependencyCycleExceptionForFormField:formField];
+    }
+}
+
+- (void)formField:(EZFormField *)formField willChangeKey:(NSString *)key
+{
+    if (nil == [self.formFieldOrdinals objectForKey:formField]) {
+	return;
+    }
+    
+    if (key && nil == [self validationDependentsOfFormField:formField forKey:key]) {
+	[self raiseValidationDependencyCycleExceptionForFormField:formField];
+    }
+    
+    // Fields depending on the previous key lose their input
+    [self setNeedsValidationOfDependentsOfFormField:formField];
+    
+    NSString *previousKey = formField.key;
+    [self unindexFormField:formField forKey:previousKey];
+    if (previousKey) {
+	[self.formFieldKeysChangedSinceSnapshot addObject:previousKey];
+	_modelVersion++;
+    }
+}
+
+- (void)formFieldDidChangeKey:(EZFormField *)formField
+{
+    if (nil == [self.formFieldOrdinals objectForKey:formField]) {
+	return;
+    }
+    
+    [self indexFormField:formField forKey:formField.key];
+    [self formFieldDidChangeModelValue:formField];
+}
+
+- (void)formField:(EZFormField *)formField didResolveValidity:(BOOL)isValid
+{
+    if (nil == [self.formFieldOrdinals objectForKey:formField]) {
+	return;
+    }
+    
+    [self.formFieldsNeedingValidation removeObject:formField];
+    self.cachedValidationReport = nil;
+    if (isValid) {
+	[self.invalidFormFields removeObject:formField];
+    }
+    else {
+	[self.invalidFormFields addObject:formField];
+    }
+}
+
+- (void)formFieldDidBeginPendingValidation:(EZFormField *)formField
+{
+    __strong id<EZFormDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(form:didBeginPendingValidationForField:)]) {
+	EZFormInstrumentation *instrumentation = self.instrumentation;
+	uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+	[delegate form:self didBeginPendingValidationForField:formField];
+	[instrumentation recordEvent:@"form:didBeginPendingValidationForField:" fieldKey:nil sinceTime:startTime];
+    }
+}
+
+- (void)formFieldDidResolvePendingValidation:(EZFormField *)formField
+{
+    __strong id<EZFormDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(form:didResolvePendingValidationForField:modelIsValid:)]) {
+	BOOL isValid = [self isFormValid];
+	EZFormInstrumentation *instrumentation = self.instrumentation;
+	uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+	[delegate form:self didResolvePendingValidationForField:formField modelIsValid:isValid];
+	[instrumentation recordEvent:@"form:didResolvePendingValidationForField:modelIsValid:" fieldKey:nil sinceTime:startTime];
+    }
+}
+
+- (void)validateFormFieldsNeedingValidation
+{
+    /* Only fields whose value or validation rules changed since they were
+     * last validated are revalidated. Validation of every other field is
+     * known from the cached results.
+     */
+    while ([self.formFieldsNeedingValidation count] > 0) {
+	EZFormField *formField = [self.formFieldsNeedingValidation firstObject];
+	BOOL isValid = [formField isValid];
+	[self formField:formField didResolveValidity:isValid];
+    }
+}
+
+- (BOOL)deferValidityIndicatorUpdateForFormField:(EZFormField *)formField
+{
+    if ([self isUpdating]) {
+	[self.formFieldsNeedingValidityIndicatorUpdate addObject:formField];
+	return YES;
+    }
+    
+    return NO;
+}
+
+- (BOOL)deferViewUpdateForFormField:(EZFormField *)formField
+{
+    if ([self isUpdating]) {
+	[self.formFieldsNeedingViewUpdate addObject:formField];
+	return YES;
+    }
+    
+    return NO;
+}
+
+- (void)notifyDelegateOfChangedFormFields:(NSArray *)formFields
+{
+    __strong id<EZFormDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(form:didUpdateValuesForFieldKeys:modelIsValid:)]) {
+	BOOL isValid = [self isFormValid];
+	NSMutableArray *keys = [NSMutableArray arrayWithCapacity:[formFields count]];
+	for (EZFormField *formField in formFields) {
+	    if (formField.key) [keys addObject:formField.key];
+	}
+	EZFormInstrumentation *instrumentation = self.instrumentation;
+	uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+	[delegate form:self didUpdateValuesForFieldKeys:keys modelIsValid:isValid];
+	[instrumentation recordEvent:@"form:didUpdateValuesForFieldKeys:modelIsValid:" fieldKey:nil sinceTime:startTime];
+    }
+    else if ([delegate respondsToSelector:@selector(form:didUpdateValueForField:modelIsValid:)]) {
+	// Validate once and report the same result for every changed field
+	BOOL isValid = [self isFormValid];
+	EZFormInstrumentation *instrumentation = self.instrumentation;
+	for (EZFormField *formField in formFields) {
+	    uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+	    [delegate form:self didUpdateValueForField:formField modelIsValid:isValid];
+	    [instrumentation recordEvent:@"form:didUpdateValueForField:modelIsValid:" fieldKey:nil sinceTime:startTime];
+	}
+    }
+}
+
+- (void)formFieldDidChangeModelValue:(EZFormField *)formField
+{
+    NSString *key = formField.key;
+    if (key && [self.formFieldOrdinals objectForKey:formField]) {
+	[self.formFieldKeysChangedSinceSnapshot addObject:key];
+	_modelVersion++;
+	[self setNeedsValidationOfDependentsOfFormField:formField];
+    }
+}
+
 - (void)formFieldDidChangeValue:(EZFormField *)formField
 {
+    EZFormDraftJournal *draftJournal = self.draftJournal;
+    if (draftJournal) {
+	[draftJournal appendModelValue:formField.modelValue forKey:formField.key];
+    }
+    
+    if (self.coalescesValueChanges && !_coalescingValueChanges) {
+	[self beginCoalescingValueChanges];
+    }
+    
+    if ([self isUpdating]) {
+	[self.formFieldsChangedDuringUpdates addObject:formField];
+	return;
+    }
+    
     __strong id<EZFormDelegate> delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(form:didUpdateValueForField:modelIsValid:)]) {
 	BOOL isValid = [self isFormValid];
+	EZFormInstrumentation *instrumentation = self.instrumentation;
+	uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
 	[delegate form:self didUpdateValueForField:formField modelIsValid:isValid];
+	[instrumentation recordEvent:@"form:didUpdateValueForField:modelIsValid:" fieldKey:nil sinceTime:startTime];
     }
 }
 
@@ -401,7 +739,7 @@
 {
     EZFormField *result = nil;
     
-    NSUInteger fieldIndex = [self.formFields indexOfObject:formField];
+    NSUInteger fieldIndex = [self indexOfFormField:formField];
     if (fieldIndex != NSNotFound) {
 	NSInteger startIndex;
 	NSInteger indexIncrement;
@@ -476,6 +814,231 @@
 }
 
 
+#pragma mark - Coalesced value changes
+
+- (void)setCoalescesValueChanges:(BOOL)coalescesValueChanges
+{
+    _coalescesValueChanges = coalescesValueChanges;
+    if (!coalescesValueChanges) {
+	[NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(endCoalescingValueChanges) object:nil];
+	[self endCoalescingValueChanges];
+    }
+}
+
+/* A burst of changes is wrapped in beginUpdates/endUpdates, so
+ * validation, view updates and delegate messages are deferred and
+ * batched exactly as for an explicit update. The batch is closed from
+ * the run loop, in common modes so it also ends while scrolling.
+ */
+- (void)beginCoalescingValueChanges
+{
+    _coalescingValueChanges = YES;
+    [self beginUpdates];
+    [self performSelector:@selector(endCoalescingValueChanges) withObject:nil afterDelay:self.valueChangeCoalescingInterval inModes:@[NSRunLoopCommonModes]];
+}
+
+- (void)endCoalescingValueChanges
+{
+    if (_coalescingValueChanges) {
+	_coalescingValueChanges = NO;
+	[self endUpdates];
+    }
+}
+
+
+#pragma mark - Field order
+
+/* Fields keep the ordinal they were added with, and removing a field
+ * leaves a gap rather than renumbering the fields after it. Ordinals
+ * increase with the index of the field, so a field's index is found by
+ * a binary search bounded by its ordinal, and directly while there are
+ * no gaps before it.
+ */
+- (NSUInteger)indexOfFormField:(EZFormField *)formField
+{
+    NSNumber *ordinalNumber = [self.formFieldOrdinals objectForKey:formField];
+    if (nil == ordinalNumber) {
+	return NSNotFound;
+    }
+    
+    NSUInteger ordinal = [ordinalNumber unsignedIntegerValue];
+    NSArray *formFields = self.formFields;
+    if (ordinal < [formFields count] && formFields[ordinal] == formField) {
+	return ordinal;
+    }
+    
+    NSUInteger low = 0;
+    NSUInteger high = MIN(ordinal, [formFields count]);
+    while (low < high) {
+	NSUInteger middle = low + (high - low) / 2;
+	if ([[self.formFieldOrdinals objectForKey:formFields[middle]] unsignedIntegerValue] < ordinal) {
+	    low = middle + 1;
+	}
+	else {
+	    high = middle;
+	}
+    }
+    return low;
+}
+
+/* Closes the gaps once they outnumber the fields, so renumbering costs
+ * constant amortized time per removal and indexes are found directly
+ * again.
+ */
+- (void)renumberFormFieldOrdinalsIfSparse
+{
+    NSUInteger count = [self.formFields count];
+    if (_nextFormFieldOrdinal - count <= count) {
+	return;
+    }
+    
+    for (NSUInteger i=0; i < count; i++) {
+	[self.formFieldOrdinals setObject:@(i) forKey:self.formFields[i]];
+    }
+    _nextFormFieldOrdinal = count;
+}
+
+
+#pragma mark - Key index
+
+- (void)indexFormField:(EZFormField *)formField forKey:(NSString *)key
+{
+    if (nil == key) {
+	return;
+    }
+    
+    // If more than one field shares a key, the first one added wins
+    EZFormField *indexedFormField = self.formFieldsByKey[key];
+    if (nil == indexedFormField || [[self.formFieldOrdinals objectForKey:formField] compare:[self.formFieldOrdinals objectForKey:indexedFormField]] == NSOrderedAscending) {
+	self.formFieldsByKey[key] = formField;
+    }
+}
+
+- (void)unindexFormField:(EZFormField *)formField forKey:(NSString *)key
+{
+    if (nil == key || self.formFieldsByKey[key] != formField) {
+	return;
+    }
+    
+    [self.formFieldsByKey removeObjectForKey:key];
+    
+    // Hand the key over to the next field sharing it, if any. Shared
+    // keys are rare, so a linear scan beats keeping per-key buckets.
+    for (EZFormField *aFormField in self.formFields) {
+	if (aFormField != formField && [aFormField.key isEqualToString:key]) {
+	    self.formFieldsByKey[key] = aFormField;
+	    break;
+	}
+    }
+}
+
+
+#pragma mark - Validation dependencies
+
+/* Fields are indexed by the keys they depend on, so the dependents of a
+ * changed field are found without looking at any unrelated field.
+ */
+- (void)addValidationDependencyKeys:(NSArray *)keys forFormField:(EZFormField *)formField
+{
+    for (NSString *key in keys) {
+	NSMutableOrderedSet *dependents = self.validationDependentsByKey[key];
+	if (nil == dependents) {
+	    dependents = [NSMutableOrderedSet orderedSet];
+	    self.validationDependentsByKey[key] = dependents;
+	}
+	[dependents addObject:formField];
+    }
+}
+
+- (void)removeValidationDependencyKeys:(NSArray *)keys forFormField:(EZFormField *)formField
+{
+    for (NSString *key in keys) {
+	NSMutableOrderedSet *dependents = self.validationDependentsByKey[key];
+	[dependents removeObject:formField];
+	if (dependents && [dependents count] == 0) {
+	    [self.validationDependentsByKey removeObjectForKey:key];
+	}
+    }
+}
+
+/* Depth-first search of the fields depending on formField. Each field is
+ * appended to postorder after everything depending on it. Returns NO if
+ * the search reaches a field it is still visiting, i.e. a cycle.
+ */
+- (BOOL)visitValidationDependentsOfFormField:(EZFormField *)formField forKey:(NSString *)key visiting:(NSMutableSet *)visiting visited:(NSMutableSet *)visited postorder:(NSMutableArray *)postorder
+{
+    [visiting addObject:formField];
+    for (EZFormField *dependent in (key ? self.validationDependentsByKey[key] : nil)) {
+	if ([visiting containsObject:dependent]) {
+	    return NO;
+	}
+	if (![visited containsObject:dependent] && ![self visitValidationDependentsOfFormField:dependent forKey:dependent.key visiting:visiting visited:visited postorder:postorder]) {
+	    return NO;
+	}
+    }
+    [visiting removeObject:formField];
+    [visited addObject:formField];
+    [postorder addObject:formField];
+    return YES;
+}
+
+/* Returns the fields depending on formField, directly or transitively,
+ * in topological order: every field comes after the fields it depends
+ * on. Returns nil if the dependencies form a cycle.
+ */
+- (NSArray *)validationDependentsOfFormField:(EZFormField *)formField
+{
+    return [self validationDependentsOfFormField:formField forKey:formField.key];
+}
+
+/* As validationDependentsOfFormField:, with formField taken to have key,
+ * to check a change of key before it is made.
+ */
+- (NSArray *)validationDependentsOfFormField:(EZFormField *)formField forKey:(NSString *)key
+{
+    if (nil == key || nil == self.validationDependentsByKey[key]) {
+	return @[];
+    }
+    
+    NSMutableArray *postorder = [NSMutableArray array];
+    if (![self visitValidationDependentsOfFormField:formField forKey:key visiting:[NSMutableSet set] visited:[NSMutableSet set] postorder:postorder]) {
+	return nil;
+    }
+    [postorder removeLastObject]; // formField itself
+    return [[postorder reverseObjectEnumerator] allObjects];
+}
+
+- (void)setNeedsValidationOfDependentsOfFormField:(EZFormField *)formField
+{
+    NSArray *dependents = [self validationDependentsOfFormField:formField];
+    if ([dependents count] == 0) {
+	return;
+    }
+    
+    // Queue dependents after the fields they depend on
+    [self.formFieldsNeedingValidation removeObjectsInArray:dependents];
+    for (EZFormField *dependent in dependents) {
+	if ([dependent isKindOfClass:[EZFormComputedField class]]) {
+	    // The computed value may change with its inputs
+	    NSString *key = dependent.key;
+	    if (key) {
+		[self.formFieldKeysChangedSinceSnapshot addObject:key];
+		_modelVersion++;
+	    }
+	    [(EZFormComputedField *)dependent inputValuesDidChange];
+	}
+	[dependent setNeedsValidation];
+    }
+}
+
+- (void)raiseValidationDependencyCycleExceptionForFormField:(EZFormField *)formField
+{
+    NSString *reason = [NSString stringWithFormat:@"Validation dependencies of form field \"%@\" form a cycle", formField.key];
+    NSException *exception = [NSException exceptionWithName:NSInvalidArgumentException reason:reason userInfo:nil];
+    @throw exception;
+}
+
+
 #pragma mark - Input Accessories
 
 - (UIView<EZFormInputAccessoryViewProtocol> *)inputAccessoryViewForType:(EZFormInputAccessoryType)type
@@ -623,6 +1186,16 @@
 {
     if ((self = [super init])) {
 	self.formFields = [NSMutableArray array];
+	self.formFieldsByKey = [NSMutableDictionary dictionary];
+	self.formFieldOrdinals = [NSMapTable strongToStrongObjectsMapTable];
+	self.formFieldsNeedingValidation = [NSMutableOrderedSet orderedSet];
+	self.invalidFormFields = [NSMutableSet set];
+	self.formFieldsChangedDuringUpdates = [NSMutableOrderedSet orderedSet];
+	self.formFieldsNeedingViewUpdate = [NSMutableOrderedSet orderedSet];
+	self.formFieldsNeedingValidityIndicatorUpdate = [NSMutableOrderedSet orderedSet];
+	self.formFieldKeysChangedSinceSnapshot = [NSMutableSet set];
+	self.snapshotLineage = [[NSObject alloc] init];
+	self.validationDependentsByKey = [NSMutableDictionary dictionary];
 	
 	_autoScrolledViewOriginalContentInset = UIEdgeInsetsZero;
 	_autoScrolledViewOriginalFrame = CGRectNull;
@@ -0,0 +1,109 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** A block that reports the result of an asynchronous validation.
+ *
+ *  Pass YES if the value is valid, NO otherwise. May be called from any
+ *  thread. Only the first call has any effect.
+ */
+typedef void (^EZFormAsyncValidationCompletion)(BOOL valid);
+
+/** A block that performs an asynchronous validation.
+ *
+ *  The block is called on the validator's queue. It receives the value to
+ *  validate, a block that returns YES once the validation is no longer
+ *  needed (because the field value changed again) and a completion block
+ *  that must be called with the result.
+ *
+ *  Long running validations should check isCancelled and give up early
+ *  when it returns YES. The completion block does not need to be called
+ *  after cancellation.
+ */
+typedef void (^EZFormAsyncValidationBlock)(id value, BOOL (^isCancelled)(void), EZFormAsyncValidationCompletion completion);
+
+
+/** A validator that runs off the main thread.
+ *
+ *  Use asynchronous validators for checks that are too slow to run while
+ *  the user is typing, such as a uniqueness lookup against a database or a
+ *  web service. Add them to a field with -[EZFormField addAsyncValidator:].
+ *
+ *  Asynchronous validators only run once all synchronous validation rules
+ *  of the field pass. Until they all complete, the field reports that its
+ *  validation is pending and it is treated as invalid.
+ */
+@interface EZFormAsyncValidator : NSObject
+
+/** The block that performs the validation.
+ */
+@property (nonatomic, readonly, copy) EZFormAsyncValidationBlock validationBlock;
+
+/** The queue the validation block is called on.
+ */
+@property (nonatomic, readonly, strong) dispatch_queue_t queue;
+
+/** Creates and returns a validator that calls the block on a global background queue.
+ *
+ *  @param block A block containing the validation logic.
+ *
+ *  @returns A configured EZFormAsyncValidator instance.
+ */
++ (instancetype)asyncValidatorWithBlock:(EZFormAsyncValidationBlock)block;
+
+/** Initialises a validator that calls the block on a global background queue.
+ *
+ *  @param block A block containing the validation logic.
+ *
+ *  @returns A configured EZFormAsyncValidator instance.
+ */
+- (instancetype)initWithBlock:(EZFormAsyncValidationBlock)block;
+
+/** Initialises a validator that calls the block on the specified queue.
+ *
+ *  @param block A block containing the validation logic.
+ *
+ *  @param queue The queue to call the block on.
+ *
+ *  @returns A configured EZFormAsyncValidator instance.
+ */
+- (instancetype)initWithBlock:(EZFormAsyncValidationBlock)block queue:(dispatch_queue_t)queue NS_DESIGNATED_INITIALIZER;
+
+/** Validates a value.
+ *
+ *  Calls the validation block on the validator's queue. The completion
+ *  block is always called on the main queue, at most once, and is not
+ *  called if isCancelled returns YES by the time the result arrives.
+ *
+ *  @param value The value to validate.
+ *
+ *  @param isCancelled A block returning YES once the result is no longer needed.
+ *
+ *  @param completion A block called on the main queue with the result.
+ */
+- (void)validateValue:(id)value isCancelled:(BOOL (^)(void))isCancelled completion:(EZFormAsyncValidationCompletion)completion;
+
+@end
@@ -0,0 +1,78 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormAsyncValidator.h"
+
+@implementation EZFormAsyncValidator
+
+
+#pragma mark - Validation
+
+- (void)validateValue:(id)value isCancelled:(BOOL (^)(void))isCancelled completion:(EZFormAsyncValidationCompletion)completion
+{
+    EZFormAsyncValidationBlock validationBlock = self.validationBlock;
+    EZFormAsyncValidationCompletion completionCopy = [completion copy];
+    
+    dispatch_async(self.queue, ^{
+	if (isCancelled()) {
+	    return;
+	}
+	
+	__block BOOL completed = NO; // only accessed on the main queue
+	validationBlock(value, isCancelled, ^(BOOL valid) {
+	    dispatch_async(dispatch_get_main_queue(), ^{
+		if (completed || isCancelled()) {
+		    return;
+		}
+		completed = YES;
+		completionCopy(valid);
+	    });
+	});
+    });
+}
+
+
+#pragma mark - Object lifecycle
+
++ (instancetype)asyncValidatorWithBlock:(EZFormAsyncValidationBlock)block
+{
+    return [[self alloc] initWithBlock:block];
+}
+
+- (instancetype)initWithBlock:(EZFormAsyncValidationBlock)block
+{
+    return [self initWithBlock:block queue:dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0)];
+}
+
+- (instancetype)initWithBlock:(EZFormAsyncValidationBlock)block queue:(dispatch_queue_t)queue
+{
+    if ((self = [super init])) {
+	_validationBlock = [block copy];
+	_queue = queue;
+    }
+    
+    return self;
+}
+
+@end
@@ -168,6 +168,15 @@ typedef NS_ENUM(NSInteger, EZFormBooleanFieldUserControlType) {
 }
 
 
+#pragma mark - Validation rules
+
+- (void)setValidationStates:(EZFormBooleanFieldState)validationStates
+{
+    _validationStates = validationStates;
+    [self setNeedsValidation];
+}
+
+
 #pragma mark - EZFormFieldConcrete methods
 
 - (BOOL)typeSpecificValidation
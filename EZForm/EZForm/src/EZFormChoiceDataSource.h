@@ -0,0 +1,88 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** A source of radio field choices that can be fetched on demand.
+ *
+ *  Assign a choice data source to -[EZFormRadioField choiceDataSource]
+ *  to present large catalogs without loading every choice up front.
+ *  The field, its picker view and EZFormRadioChoiceViewController fetch
+ *  choices a page at a time, as they are displayed, and keep only a
+ *  bounded number of recently used pages in memory (see
+ *  EZFormChoicePageCache).
+ *
+ *  All methods are called on the main thread.
+ *
+ *  EZFormChoiceStore conforms to this protocol.
+ */
+@protocol EZFormChoiceDataSource <NSObject>
+
+/** Returns the total number of choices.
+ */
+- (NSUInteger)numberOfChoices;
+
+/** Fetches the keys and values of a range of choices.
+ *
+ *  @param keys On return, an array of range.length choice keys.
+ *
+ *  @param values On return, an array of range.length choice values.
+ *
+ *  @param range The range of choice indexes to fetch.
+ */
+- (void)getChoiceKeys:(NSArray **)keys values:(NSArray **)values inRange:(NSRange)range;
+
+/** Returns the value of the choice with a key.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns The choice value, or nil if there is no choice with the key.
+ */
+- (id)choiceValueForKey:(id)key;
+
+@optional
+
+/** Returns the index of the choice with a key.
+ *
+ *  If not implemented, a picker view cannot show the selected choice
+ *  until the user scrolls to it.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns The index of the choice, or NSNotFound.
+ */
+- (NSUInteger)indexOfChoiceKey:(id)key;
+
+/** Returns the keys of choices matching a search string.
+ *
+ *  If not implemented, only the choices already fetched are searched.
+ *
+ *  @param searchString The text to search for.
+ *
+ *  @returns An array of matching choice keys.
+ */
+- (NSArray *)choiceKeysMatchingSearchString:(NSString *)searchString;
+
+@end
@@ -0,0 +1,99 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "EZFormChoiceDataSource.h"
+
+
+/** A bounded cache of pages of choices fetched from a choice data source.
+ *
+ *  Choices are fetched a page at a time when first accessed. Once more
+ *  than capacity pages are cached, the least recently used page is
+ *  discarded.
+ */
+@interface EZFormChoicePageCache : NSObject
+
+/** The data source choices are fetched from.
+ */
+@property (nonatomic, strong, readonly) id<EZFormChoiceDataSource> dataSource;
+
+/** The number of choices fetched at a time.
+ *
+ *  Default is 50.
+ */
+@property (nonatomic, assign) NSUInteger pageSize;
+
+/** The maximum number of pages kept in memory.
+ *
+ *  Default is 8.
+ */
+@property (nonatomic, assign) NSUInteger capacity;
+
+/** Initialises a page cache for a data source.
+ *
+ *  @param dataSource The data source to fetch choices from.
+ *
+ *  @returns Initialised EZFormChoicePageCache object.
+ */
+- (instancetype)initWithDataSource:(id<EZFormChoiceDataSource>)dataSource NS_DESIGNATED_INITIALIZER;
+
+/** The number of choices, as reported by the data source.
+ *
+ *  The count is cached until removeAllPages is called.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** Returns the key of the choice at an index, fetching its page if needed.
+ *
+ *  @param index An index less than count.
+ *
+ *  @returns The choice key.
+ */
+- (id)keyAtIndex:(NSUInteger)index;
+
+/** Returns the value of the choice at an index, fetching its page if needed.
+ *
+ *  @param index An index less than count.
+ *
+ *  @returns The choice value.
+ */
+- (id)valueAtIndex:(NSUInteger)index;
+
+/** Returns the keys and values of the choices in cached pages, in choice
+ *  order, without fetching anything.
+ *
+ *  @param keys On return, the keys of the cached choices.
+ *
+ *  @param values On return, the values of the cached choices, one for
+ *  each key.
+ */
+- (void)getCachedChoiceKeys:(NSArray **)keys values:(NSArray **)values;
+
+/** Discards all cached pages and the cached count.
+ *
+ *  Call when the choices of the data source change.
+ */
+- (void)removeAllPages;
+
+@end
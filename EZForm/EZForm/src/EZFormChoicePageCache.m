@@ -0,0 +1,173 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormChoicePageCache.h"
+
+
+#pragma mark - EZFormChoicePage
+
+@interface EZFormChoicePage : NSObject
+@property (nonatomic, copy) NSArray *keys;
+@property (nonatomic, copy) NSArray *values;
+@end
+
+@implementation EZFormChoicePage
+@end
+
+
+#pragma mark - EZFormChoicePageCache class extension
+
+@interface EZFormChoicePageCache () {
+    NSUInteger _count;
+    BOOL _countIsValid;
+}
+
+@property (nonatomic, strong, readwrite) id<EZFormChoiceDataSource> dataSource;
+@property (nonatomic, strong) NSMutableDictionary *pages;		// page number -> EZFormChoicePage
+@property (nonatomic, strong) NSMutableOrderedSet *recentPageNumbers;	// least recently used first
+
+@end
+
+
+#pragma mark - EZFormChoicePageCache implementation
+
+@implementation EZFormChoicePageCache
+
+- (NSUInteger)count
+{
+    if (! _countIsValid) {
+	_count = [self.dataSource numberOfChoices];
+	_countIsValid = YES;
+    }
+    return _count;
+}
+
+- (id)keyAtIndex:(NSUInteger)index
+{
+    EZFormChoicePage *page = [self pageForIndex:index];
+    return page.keys[index % self.pageSize];
+}
+
+- (id)valueAtIndex:(NSUInteger)index
+{
+    EZFormChoicePage *page = [self pageForIndex:index];
+    return page.values[index % self.pageSize];
+}
+
+- (void)getCachedChoiceKeys:(NSArray **)keys values:(NSArray **)values
+{
+    NSArray *pageNumbers = [[self.pages allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *cachedKeys = [NSMutableArray arrayWithCapacity:[pageNumbers count] * self.pageSize];
+    NSMutableArray *cachedValues = [NSMutableArray arrayWithCapacity:[pageNumbers count] * self.pageSize];
+    for (NSNumber *pageNumber in pageNumbers) {
+	EZFormChoicePage *page = self.pages[pageNumber];
+	[cachedKeys addObjectsFromArray:page.keys];
+	[cachedValues addObjectsFromArray:page.values];
+    }
+    
+    if (keys) *keys = cachedKeys;
+    if (values) *values = cachedValues;
+}
+
+- (void)removeAllPages
+{
+    [self.pages removeAllObjects];
+    [self.recentPageNumbers removeAllObjects];
+    _countIsValid = NO;
+}
+
+- (void)setPageSize:(NSUInteger)pageSize
+{
+    _pageSize = MAX(pageSize, 1U);
+    [self removeAllPages];
+}
+
+- (void)setCapacity:(NSUInteger)capacity
+{
+    _capacity = MAX(capacity, 1U);
+    [self evictPagesOverCapacity];
+}
+
+
+#pragma mark - Pages
+
+- (EZFormChoicePage *)pageForIndex:(NSUInteger)index
+{
+    if (index >= [self count]) {
+	@throw [NSException exceptionWithName:NSRangeException reason:[NSString stringWithFormat:@"Choice index %lu beyond bounds", (unsigned long)index] userInfo:nil];
+    }
+    
+    NSNumber *pageNumber = @(index / self.pageSize);
+    EZFormChoicePage *page = self.pages[pageNumber];
+    if (nil == page) {
+	NSUInteger location = [pageNumber unsignedIntegerValue] * self.pageSize;
+	NSRange range = NSMakeRange(location, MIN(self.pageSize, [self count] - location));
+	
+	NSArray *keys = nil;
+	NSArray *values = nil;
+	[self.dataSource getChoiceKeys:&keys values:&values inRange:range];
+	if ([keys count] != range.length || [values count] != range.length) {
+	    @throw [NSException exceptionWithName:NSInternalInconsistencyException reason:@"Choice data source returned the wrong number of choices" userInfo:nil];
+	}
+	
+	page = [[EZFormChoicePage alloc] init];
+	page.keys = keys;
+	page.values = values;
+	self.pages[pageNumber] = page;
+    }
+    
+    // Mark as most recently used
+    [self.recentPageNumbers removeObject:pageNumber];
+    [self.recentPageNumbers addObject:pageNumber];
+    [self evictPagesOverCapacity];
+    
+    return page;
+}
+
+- (void)evictPagesOverCapacity
+{
+    while ([self.recentPageNumbers count] > self.capacity) {
+	NSNumber *pageNumber = [self.recentPageNumbers firstObject];
+	[self.pages removeObjectForKey:pageNumber];
+	[self.recentPageNumbers removeObjectAtIndex:0];
+    }
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithDataSource:(id<EZFormChoiceDataSource>)dataSource
+{
+    if ((self = [super init])) {
+	_dataSource = dataSource;
+	_pageSize = 50;
+	_capacity = 8;
+	_pages = [[NSMutableDictionary alloc] init];
+	_recentPageNumbers = [[NSMutableOrderedSet alloc] init];
+    }
+    
+    return self;
+}
+
+@end
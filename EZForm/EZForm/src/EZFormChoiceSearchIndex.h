@@ -0,0 +1,78 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** A type-ahead search index over choice display values.
+ *
+ *  Display values are split into words, folded to ignore case and
+ *  diacritics, and kept sorted, so that all words starting with a
+ *  prefix are found with a binary search. Searching costs roughly the
+ *  number of matching words rather than the number of choices.
+ *
+ *  A choice matches a search string if every word of the search string
+ *  is a prefix of some word of the choice's display value. For example
+ *  "new yo" matches "New York" and "São" matches "Sao Paulo".
+ *
+ *  An index is immutable. EZFormRadioField builds one lazily for its
+ *  choices; see -[EZFormRadioField choiceKeysMatchingSearchString:].
+ */
+@interface EZFormChoiceSearchIndex : NSObject
+
+/** Builds a search index over choices.
+ *
+ *  @param keys An array of choice keys.
+ *
+ *  @param values An array of choice display values, one for each key.
+ *  Values that are not strings are indexed by their description.
+ *
+ *  @returns Initialised EZFormChoiceSearchIndex object.
+ */
+- (instancetype)initWithKeys:(NSArray *)keys values:(NSArray *)values NS_DESIGNATED_INITIALIZER;
+
+/** The number of indexed choices.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** Returns the indexes of choices matching a search string, in choice
+ *  order.
+ *
+ *  An empty search string matches every choice.
+ *
+ *  @param searchString The text to search for.
+ *
+ *  @returns The indexes of matching choices.
+ */
+- (NSIndexSet *)indexesOfChoicesMatchingSearchString:(NSString *)searchString;
+
+/** Returns the keys of choices matching a search string, in choice order.
+ *
+ *  @param searchString The text to search for.
+ *
+ *  @returns An array of matching choice keys.
+ */
+- (NSArray *)keysOfChoicesMatchingSearchString:(NSString *)searchString;
+
+@end
@@ -0,0 +1,263 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormChoiceSearchIndex.h"
+
+
+/* One word of a choice display value. Words are retained by the
+ * index's words array.
+ */
+typedef struct {
+    __unsafe_unretained NSString *word;
+    NSUInteger choiceIndex;
+} EZFormChoiceSearchEntry;
+
+
+static NSString *
+EZFormChoiceSearchFoldString(NSString *string)
+{
+    return [string stringByFoldingWithOptions:(NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch) locale:nil];
+}
+
+static NSArray *
+EZFormChoiceSearchWordsInString(NSString *string)
+{
+    static NSCharacterSet *separatorCharset = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	separatorCharset = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+    });
+    
+    NSMutableArray *words = [NSMutableArray array];
+    for (NSString *word in [EZFormChoiceSearchFoldString(string) componentsSeparatedByCharactersInSet:separatorCharset]) {
+	if ([word length] > 0) {
+	    [words addObject:word];
+	}
+    }
+    return words;
+}
+
+static int
+EZFormChoiceSearchCompareIndexes(const void *a, const void *b)
+{
+    NSUInteger indexA = *(const NSUInteger *)a;
+    NSUInteger indexB = *(const NSUInteger *)b;
+    return (indexA < indexB ? -1 : (indexA > indexB ? 1 : 0));
+}
+
+/* Keeps the indexes of a sorted, distinct array that are also in another
+ * one, in place. Returns the number kept.
+ */
+static NSUInteger
+EZFormChoiceSearchIntersectIndexes(NSUInteger *indexes, NSUInteger count, const NSUInteger *otherIndexes, NSUInteger otherCount)
+{
+    NSUInteger keptCount = 0;
+    NSUInteger i = 0;
+    NSUInteger j = 0;
+    while (i < count && j < otherCount) {
+	if (indexes[i] < otherIndexes[j]) {
+	    i++;
+	}
+	else if (indexes[i] > otherIndexes[j]) {
+	    j++;
+	}
+	else {
+	    indexes[keptCount++] = indexes[i];
+	    i++;
+	    j++;
+	}
+    }
+    return keptCount;
+}
+
+/* Builds an index set from a sorted, distinct array, a run of consecutive
+ * indexes at a time.
+ */
+static NSIndexSet *
+EZFormChoiceSearchIndexSetWithIndexes(const NSUInteger *indexes, NSUInteger count)
+{
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+    NSUInteger i = 0;
+    while (i < count) {
+	NSUInteger runStart = i;
+	while (i + 1 < count && indexes[i + 1] == indexes[i] + 1) {
+	    i++;
+	}
+	[indexSet addIndexesInRange:NSMakeRange(indexes[runStart], indexes[i] - indexes[runStart] + 1)];
+	i++;
+    }
+    return indexSet;
+}
+
+
+#pragma mark - EZFormChoiceSearchIndex class extension
+
+@interface EZFormChoiceSearchIndex () {
+    EZFormChoiceSearchEntry *_entries;	// sorted by word
+    NSUInteger _entryCount;
+}
+
+@property (nonatomic, copy) NSArray *keys;
+@property (nonatomic, strong) NSArray *words;	// owns the words referenced by _entries
+
+@end
+
+
+#pragma mark - EZFormChoiceSearchIndex implementation
+
+@implementation EZFormChoiceSearchIndex
+
+- (NSUInteger)count
+{
+    return [self.keys count];
+}
+
+
+#pragma mark - Searching
+
+/* Returns a malloc'd array, to be freed by the caller, of the distinct
+ * indexes of the choices with a word starting with prefix, in order, and
+ * their number in count.
+ */
+- (NSUInteger *)copyIndexesOfChoicesMatchingWordPrefix:(NSString *)prefix count:(NSUInteger *)count
+{
+    // Binary search for the first word not ordered before the prefix
+    NSUInteger low = 0;
+    NSUInteger high = _entryCount;
+    while (low < high) {
+	NSUInteger middle = low + (high - low) / 2;
+	if ([_entries[middle].word compare:prefix options:NSLiteralSearch] == NSOrderedAscending) {
+	    low = middle + 1;
+	}
+	else {
+	    high = middle;
+	}
+    }
+    
+    // Words starting with the prefix follow each other, in word order
+    NSUInteger end = low;
+    while (end < _entryCount && [_entries[end].word hasPrefix:prefix]) {
+	end++;
+    }
+    
+    NSUInteger matchCount = end - low;
+    NSUInteger *indexes = malloc(MAX(matchCount, 1U) * sizeof(NSUInteger));
+    for (NSUInteger i=0; i < matchCount; i++) {
+	indexes[i] = _entries[low + i].choiceIndex;
+    }
+    qsort(indexes, matchCount, sizeof(NSUInteger), EZFormChoiceSearchCompareIndexes);
+    
+    // A choice with several matching words is listed once
+    NSUInteger distinctCount = 0;
+    for (NSUInteger i=0; i < matchCount; i++) {
+	if (distinctCount == 0 || indexes[distinctCount - 1] != indexes[i]) {
+	    indexes[distinctCount++] = indexes[i];
+	}
+    }
+    
+    *count = distinctCount;
+    return indexes;
+}
+
+- (NSIndexSet *)indexesOfChoicesMatchingSearchString:(NSString *)searchString
+{
+    NSArray *searchWords = EZFormChoiceSearchWordsInString(searchString ?: @"");
+    if ([searchWords count] == 0) {
+	return [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, [self count])];
+    }
+    
+    NSUInteger *matches = NULL;
+    NSUInteger matchCount = 0;
+    for (NSString *searchWord in searchWords) {
+	NSUInteger wordMatchCount = 0;
+	NSUInteger *wordMatches = [self copyIndexesOfChoicesMatchingWordPrefix:searchWord count:&wordMatchCount];
+	if (NULL == matches) {
+	    matches = wordMatches;
+	    matchCount = wordMatchCount;
+	}
+	else {
+	    matchCount = EZFormChoiceSearchIntersectIndexes(matches, matchCount, wordMatches, wordMatchCount);
+	    free(wordMatches);
+	}
+	if (matchCount == 0) break;
+    }
+    
+    NSIndexSet *indexSet = EZFormChoiceSearchIndexSetWithIndexes(matches, matchCount);
+    free(matches);
+    return indexSet;
+}
+
+- (NSArray *)keysOfChoicesMatchingSearchString:(NSString *)searchString
+{
+    return [self.keys objectsAtIndexes:[self indexesOfChoicesMatchingSearchString:searchString]];
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithKeys:(NSArray *)keys values:(NSArray *)values
+{
+    if ((self = [super init])) {
+	if ([keys count] != [values count]) {
+	    @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Choice keys and values must have the same count" userInfo:nil];
+	}
+	
+	_keys = [keys copy];
+	
+	NSMutableArray *words = [NSMutableArray array];
+	NSMutableData *entries = [NSMutableData data];
+	[values enumerateObjectsUsingBlock:^(id value, NSUInteger idx, __unused BOOL *stop) {
+	    NSString *string = ([value isKindOfClass:[NSString class]] ? value : [value description]);
+	    for (NSString *word in EZFormChoiceSearchWordsInString(string)) {
+		[words addObject:word];
+		EZFormChoiceSearchEntry entry = { word, idx };
+		[entries appendBytes:&entry length:sizeof(entry)];
+	    }
+	}];
+	_words = words;
+	
+	_entryCount = [entries length] / sizeof(EZFormChoiceSearchEntry);
+	_entries = malloc(MAX([entries length], 1U));
+	memcpy(_entries, [entries bytes], [entries length]);
+	
+	qsort_b(_entries, _entryCount, sizeof(EZFormChoiceSearchEntry), ^int(const void *a, const void *b) {
+	    const EZFormChoiceSearchEntry *entryA = a;
+	    const EZFormChoiceSearchEntry *entryB = b;
+	    NSComparisonResult order = [entryA->word compare:entryB->word options:NSLiteralSearch];
+	    if (order == NSOrderedSame) {
+		order = (entryA->choiceIndex < entryB->choiceIndex ? NSOrderedAscending : (entryA->choiceIndex > entryB->choiceIndex ? NSOrderedDescending : NSOrderedSame));
+	    }
+	    return (int)order;
+	});
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_entries);
+}
+
+@end
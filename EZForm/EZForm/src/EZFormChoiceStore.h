@@ -0,0 +1,173 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "EZFormChoiceDataSource.h"
+
+/** Posted after choices are added to or changed in a choice store, once
+ *  per call. The notification object is the store.
+ */
+extern NSString * const EZFormChoiceStoreDidChangeNotification;
+
+/** An ordered collection of radio field choices.
+ *
+ *  A choice store keeps choices in order and indexes them by key, so
+ *  looking up a choice by key or finding its position takes constant
+ *  time regardless of the number of choices. Keys are unique: adding a
+ *  choice with a key already in the store replaces its value and keeps
+ *  its position.
+ *
+ *  A store created with integer keys (see initWithIntegerKeys:values:count:)
+ *  indexes the keys as plain integers, without creating an NSNumber for
+ *  each of them. NSNumber keys are accepted for lookups and added to an
+ *  integer key store by their integerValue.
+ *
+ *  Also see -[EZFormRadioField choiceStore].
+ */
+@interface EZFormChoiceStore : NSObject <NSCopying, EZFormChoiceDataSource>
+
+/** Initialises an empty choice store.
+ */
+- (instancetype)init;
+
+/** Initialises a choice store with keys and values, in order.
+ *
+ *  @param keys An array of choice keys.
+ *
+ *  @param values An array of choice values, one for each key.
+ *
+ *  @returns Initialised EZFormChoiceStore object.
+ */
+- (instancetype)initWithKeys:(NSArray *)keys values:(NSArray *)values;
+
+/** Initialises a choice store with integer keys and values, in order.
+ *
+ *  @param keys A C array of count choice keys.
+ *
+ *  @param values An array of count choice values.
+ *
+ *  @param count The number of choices.
+ *
+ *  @returns Initialised EZFormChoiceStore object.
+ */
+- (instancetype)initWithIntegerKeys:(const NSInteger *)keys values:(NSArray *)values count:(NSUInteger)count;
+
+/** Whether the store indexes its keys as integers.
+ */
+@property (nonatomic, readonly, getter=hasIntegerKeys) BOOL integerKeys;
+
+/** The number of choices.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** A counter incremented every time a choice is added or changed.
+ */
+@property (nonatomic, readonly) NSUInteger changeCount;
+
+/** All choice keys, in order.
+ */
+@property (nonatomic, readonly, copy) NSArray *allKeys;
+
+/** The choices as a dictionary of keys to values.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *dictionaryRepresentation;
+
+/** Returns the key of the choice at an index.
+ *
+ *  @param index An index less than count.
+ *
+ *  @returns The choice key. For an integer key store this is an NSNumber.
+ */
+- (id)keyAtIndex:(NSUInteger)index;
+
+/** Returns the value of the choice at an index.
+ *
+ *  @param index An index less than count.
+ *
+ *  @returns The choice value.
+ */
+- (id)valueAtIndex:(NSUInteger)index;
+
+/** Returns the position of the choice with a key.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns The index of the choice, or NSNotFound.
+ */
+- (NSUInteger)indexOfKey:(id)key;
+
+/** Returns the position of the choice with an integer key.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns The index of the choice, or NSNotFound.
+ */
+- (NSUInteger)indexOfIntegerKey:(NSInteger)key;
+
+/** Returns the value of the choice with a key.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns The choice value, or nil if there is no choice with the key.
+ */
+- (id)choiceValueForKey:(id)key;
+
+/** Returns a boolean indicating whether the store has a choice with a key.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns YES if a choice has the key, NO otherwise.
+ */
+- (BOOL)containsKey:(id)key;
+
+/** Adds a choice, or replaces the value of the choice with the same key.
+ *
+ *  Raises an NSInvalidArgumentException when adding a key that is not
+ *  an NSNumber to an integer key store.
+ *
+ *  @param value The choice value.
+ *
+ *  @param key The choice key.
+ */
+- (void)setChoiceValue:(id)value forKey:(id)key;
+
+/** Adds a choice with an integer key, or replaces the value of the choice
+ *  with the same key.
+ *
+ *  @param value The choice value.
+ *
+ *  @param key The choice key.
+ */
+- (void)setChoiceValue:(id)value forIntegerKey:(NSInteger)key;
+
+/** Adds choices in order. Choices with keys already in the store
+ *  replace the existing values.
+ *
+ *  @param keys An array of choice keys.
+ *
+ *  @param values An array of choice values, one for each key.
+ */
+- (void)addChoicesWithKeys:(NSArray *)keys values:(NSArray *)values;
+
+@end
@@ -0,0 +1,340 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormChoiceStore.h"
+
+NSString * const EZFormChoiceStoreDidChangeNotification = @"EZFormChoiceStoreDidChangeNotification";
+
+
+/* Both key indexes map a key to its choice index plus one, stored
+ * directly in the dictionary value pointer, so that a missing key (NULL)
+ * can be told apart from index 0 and no index is ever boxed.
+ */
+static inline NSUInteger
+EZFormChoiceStoreIndexFromIndexValue(const void *indexValue)
+{
+    return (NSUInteger)(uintptr_t)indexValue - 1;
+}
+
+static inline const void *
+EZFormChoiceStoreIndexValueFromIndex(NSUInteger index)
+{
+    return (const void *)(uintptr_t)(index + 1);
+}
+
+
+#pragma mark - EZFormChoiceStore class extension
+
+@interface EZFormChoiceStore () {
+    NSMutableArray *_keys;	// object keys, in order; unused for integer keys
+    NSMutableData *_integerKeys;	// NSInteger keys, in order; nil for object keys
+    NSMutableArray *_values;
+    CFMutableDictionaryRef _keyIndex;
+    NSDictionary *_dictionaryRepresentation;	// cached
+}
+@end
+
+
+#pragma mark - EZFormChoiceStore implementation
+
+@implementation EZFormChoiceStore
+
+
+#pragma mark - Accessing choices
+
+- (BOOL)hasIntegerKeys
+{
+    return (nil != _integerKeys);
+}
+
+- (NSUInteger)count
+{
+    return [_values count];
+}
+
+- (NSArray *)allKeys
+{
+    if (nil == _integerKeys) {
+	return [_keys copy];
+    }
+    
+    NSUInteger count = [self count];
+    const NSInteger *integerKeys = [_integerKeys bytes];
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i=0; i < count; i++) {
+	[keys addObject:@(integerKeys[i])];
+    }
+    return keys;
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    if (nil == _dictionaryRepresentation) {
+	_dictionaryRepresentation = [NSDictionary dictionaryWithObjects:_values forKeys:[self allKeys]];
+    }
+    return _dictionaryRepresentation;
+}
+
+- (id)keyAtIndex:(NSUInteger)index
+{
+    if (_integerKeys) {
+	if (index >= [self count]) {
+	    @throw [NSException exceptionWithName:NSRangeException reason:[NSString stringWithFormat:@"Choice index %lu beyond bounds", (unsigned long)index] userInfo:nil];
+	}
+	const NSInteger *integerKeys = [_integerKeys bytes];
+	return @(integerKeys[index]);
+    }
+    return _keys[index];
+}
+
+- (id)valueAtIndex:(NSUInteger)index
+{
+    return _values[index];
+}
+
+- (NSUInteger)indexOfKey:(id)key
+{
+    if (nil == key) {
+	return NSNotFound;
+    }
+    if (_integerKeys) {
+	if (! [key isKindOfClass:[NSNumber class]]) {
+	    return NSNotFound;
+	}
+	return [self indexOfIntegerKey:[(NSNumber *)key integerValue]];
+    }
+    
+    const void *indexValue = NULL;
+    if (CFDictionaryGetValueIfPresent(_keyIndex, (__bridge const void *)key, &indexValue)) {
+	return EZFormChoiceStoreIndexFromIndexValue(indexValue);
+    }
+    return NSNotFound;
+}
+
+- (NSUInteger)indexOfIntegerKey:(NSInteger)key
+{
+    if (nil == _integerKeys) {
+	return [self indexOfKey:@(key)];
+    }
+    
+    const void *indexValue = NULL;
+    if (CFDictionaryGetValueIfPresent(_keyIndex, (const void *)(intptr_t)key, &indexValue)) {
+	return EZFormChoiceStoreIndexFromIndexValue(indexValue);
+    }
+    return NSNotFound;
+}
+
+- (id)choiceValueForKey:(id)key
+{
+    NSUInteger index = [self indexOfKey:key];
+    return (index != NSNotFound ? _values[index] : nil);
+}
+
+- (BOOL)containsKey:(id)key
+{
+    return ([self indexOfKey:key] != NSNotFound);
+}
+
+
+#pragma mark - Adding choices
+
+- (void)setChoiceValue:(id)value forKey:(id)key
+{
+    [self storeChoiceValue:value forKey:key];
+    [self postDidChangeNotification];
+}
+
+- (void)setChoiceValue:(id)value forIntegerKey:(NSInteger)key
+{
+    [self storeChoiceValue:value forIntegerKey:key];
+    [self postDidChangeNotification];
+}
+
+- (void)addChoicesWithKeys:(NSArray *)keys values:(NSArray *)values
+{
+    if ([keys count] != [values count]) {
+	@throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Choice keys and values must have the same count" userInfo:nil];
+    }
+    
+    NSUInteger count = [keys count];
+    for (NSUInteger i=0; i < count; i++) {
+	[self storeChoiceValue:values[i] forKey:keys[i]];
+    }
+    [self postDidChangeNotification];
+}
+
+- (void)postDidChangeNotification
+{
+    [[NSNotificationCenter defaultCenter] postNotificationName:EZFormChoiceStoreDidChangeNotification object:self];
+}
+
+/* Adds or replaces a choice without posting a change notification.
+ */
+- (void)storeChoiceValue:(id)value forKey:(id)key
+{
+    if (_integerKeys) {
+	if (! [key isKindOfClass:[NSNumber class]]) {
+	    @throw [NSException exceptionWithName:NSInvalidArgumentException reason:[NSString stringWithFormat:@"Choice key %@ is not an integer", key] userInfo:nil];
+	}
+	[self storeChoiceValue:value forIntegerKey:[(NSNumber *)key integerValue]];
+	return;
+    }
+    
+    NSUInteger index = [self indexOfKey:key];
+    if (index != NSNotFound) {
+	_values[index] = value;
+    }
+    else {
+	CFDictionarySetValue(_keyIndex, (__bridge const void *)key, EZFormChoiceStoreIndexValueFromIndex([_values count]));
+	[_keys addObject:key];
+	[_values addObject:value];
+    }
+    _dictionaryRepresentation = nil;
+    _changeCount++;
+}
+
+- (void)storeChoiceValue:(id)value forIntegerKey:(NSInteger)key
+{
+    if (nil == _integerKeys) {
+	[self storeChoiceValue:value forKey:@(key)];
+	return;
+    }
+    
+    NSUInteger index = [self indexOfIntegerKey:key];
+    if (index != NSNotFound) {
+	_values[index] = value;
+    }
+    else {
+	CFDictionarySetValue(_keyIndex, (const void *)(intptr_t)key, EZFormChoiceStoreIndexValueFromIndex([_values count]));
+	[_integerKeys appendBytes:&key length:sizeof(key)];
+	[_values addObject:value];
+    }
+    _dictionaryRepresentation = nil;
+    _changeCount++;
+}
+
+
+#pragma mark - EZFormChoiceDataSource
+
+- (NSUInteger)numberOfChoices
+{
+    return [self count];
+}
+
+- (void)getChoiceKeys:(NSArray **)keys values:(NSArray **)values inRange:(NSRange)range
+{
+    if (keys) {
+	if (_integerKeys) {
+	    NSMutableArray *rangeKeys = [NSMutableArray arrayWithCapacity:range.length];
+	    for (NSUInteger i=range.location; i < NSMaxRange(range); i++) {
+		[rangeKeys addObject:[self keyAtIndex:i]];
+	    }
+	    *keys = rangeKeys;
+	}
+	else {
+	    *keys = [_keys subarrayWithRange:range];
+	}
+    }
+    if (values) {
+	*values = [_values subarrayWithRange:range];
+    }
+}
+
+- (NSUInteger)indexOfChoiceKey:(id)key
+{
+    return [self indexOfKey:key];
+}
+
+
+#pragma mark - NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    EZFormChoiceStore *copy = [[[self class] allocWithZone:zone] init];
+    copy->_keys = [_keys mutableCopy];
+    copy->_integerKeys = [_integerKeys mutableCopy];
+    copy->_values = [_values mutableCopy];
+    CFRelease(copy->_keyIndex);
+    copy->_keyIndex = CFDictionaryCreateMutableCopy(kCFAllocatorDefault, 0, _keyIndex);
+    copy->_dictionaryRepresentation = _dictionaryRepresentation;
+    copy->_changeCount = _changeCount;
+    return copy;
+}
+
+
+#pragma mark - NSObject methods
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p count=%lu>", [self class], self, (unsigned long)[self count]];
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)init
+{
+    if ((self = [super init])) {
+	_keys = [[NSMutableArray alloc] init];
+	_values = [[NSMutableArray alloc] init];
+	_keyIndex = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithKeys:(NSArray *)keys values:(NSArray *)values
+{
+    if ((self = [self init])) {
+	[self addChoicesWithKeys:keys values:values];
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithIntegerKeys:(const NSInteger *)keys values:(NSArray *)values count:(NSUInteger)count
+{
+    if ((self = [super init])) {
+	if ([values count] != count) {
+	    @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Choice keys and values must have the same count" userInfo:nil];
+	}
+	
+	_integerKeys = [[NSMutableData alloc] initWithCapacity:count * sizeof(NSInteger)];
+	_values = [[NSMutableArray alloc] initWithCapacity:count];
+	_keyIndex = CFDictionaryCreateMutable(kCFAllocatorDefault, (CFIndex)count, NULL, NULL);
+	
+	for (NSUInteger i=0; i < count; i++) {
+	    [self storeChoiceValue:values[i] forIntegerKey:keys[i]];
+	}
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_keyIndex) CFRelease(_keyIndex);
+}
+
+@end
@@ -43,6 +43,14 @@ extern EZFormFieldValidator EZFormEmailAddressValidator;
  */
 extern BOOL (^EZFormEmailAddressInputFilter)(id);
 
+/** A block-based numeric input delta filter.
+ *
+ *  For use with -[EZFormTextField addInputDeltaFilter:]. Allows an edit
+ *  only if the replacement string is all decimal digits. Only the
+ *  replacement string is inspected.
+ */
+extern BOOL (^EZFormNumericInputDeltaFilter)(NSString *, NSRange, NSString *);
+
 
 
 /** Validation and input filter functions
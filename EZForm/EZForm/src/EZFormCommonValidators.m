@@ -37,6 +37,77 @@ BOOL (^EZFormEmailAddressInputFilter)(id) = ^(id input)
     return EZFormFilterInputForEmailAddressFormat(input);
 };
 
+BOOL (^EZFormNumericInputDeltaFilter)(NSString *, NSRange, NSString *) = ^(__unused NSString *text, __unused NSRange range, NSString *replacement)
+{
+    static NSCharacterSet *nonNumericCharset = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	nonNumericCharset = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+    });
+    
+    return (BOOL)([replacement rangeOfCharacterFromSet:nonNumericCharset].location == NSNotFound);
+};
+
+
+#pragma mark - Email address state machine
+
+/* Email address validation and input filtering are done in a single pass
+ * over the string's UTF-16 characters, driven by the transition tables
+ * below. Nothing is allocated.
+ */
+
+typedef NS_ENUM(uint8_t, EZFormEmailCharacterClass) {
+    EZFormEmailCharacterClassOther = 0,
+    EZFormEmailCharacterClassAt,	// "@"
+    EZFormEmailCharacterClassDot,	// "."
+} ;
+
+typedef NS_ENUM(uint8_t, EZFormEmailScanState) {
+    EZFormEmailScanStateStart = 0,	// nothing read yet
+    EZFormEmailScanStateLocal,		// in local part
+    EZFormEmailScanStateDomainStart,	// just read the "@"
+    EZFormEmailScanStateDomain,		// in domain, no "." yet
+    EZFormEmailScanStateDomainDot,	// in domain, just read a "."
+    EZFormEmailScanStateDomainDotted,	// in domain, after a "."
+    EZFormEmailScanStateReject,
+} ;
+
+#define EZFormEmailScanStateCount 7
+#define EZFormEmailCharacterClassCount 3
+
+static const EZFormEmailScanState EZFormEmailFormatTransitions[EZFormEmailScanStateCount][EZFormEmailCharacterClassCount] = {
+    //                                    Other                             "@"                              "."
+    /* Start */		{ EZFormEmailScanStateLocal,         EZFormEmailScanStateReject,      EZFormEmailScanStateLocal },
+    /* Local */		{ EZFormEmailScanStateLocal,         EZFormEmailScanStateDomainStart, EZFormEmailScanStateLocal },
+    /* DomainStart */	{ EZFormEmailScanStateDomain,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+    /* Domain */	{ EZFormEmailScanStateDomain,        EZFormEmailScanStateReject,      EZFormEmailScanStateDomainDot },
+    /* DomainDot */	{ EZFormEmailScanStateDomainDotted,  EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+    /* DomainDotted */	{ EZFormEmailScanStateDomainDotted,  EZFormEmailScanStateReject,      EZFormEmailScanStateDomainDot },
+    /* Reject */	{ EZFormEmailScanStateReject,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+};
+
+/* The input filter only uses the Local, Domain, DomainDot and Reject states:
+ * partial input may start with "@" or have "." straight after the "@".
+ */
+static const EZFormEmailScanState EZFormEmailInputFilterTransitions[EZFormEmailScanStateCount][EZFormEmailCharacterClassCount] = {
+    //                                    Other                             "@"                              "."
+    /* Start */		{ EZFormEmailScanStateReject,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+    /* Local */		{ EZFormEmailScanStateLocal,         EZFormEmailScanStateDomain,      EZFormEmailScanStateLocal },
+    /* DomainStart */	{ EZFormEmailScanStateReject,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+    /* Domain */	{ EZFormEmailScanStateDomain,        EZFormEmailScanStateReject,      EZFormEmailScanStateDomainDot },
+    /* DomainDot */	{ EZFormEmailScanStateDomain,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+    /* DomainDotted */	{ EZFormEmailScanStateReject,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+    /* Reject */	{ EZFormEmailScanStateReject,        EZFormEmailScanStateReject,      EZFormEmailScanStateReject },
+};
+
+static inline EZFormEmailCharacterClass
+EZFormEmailCharacterClassForCharacter(UniChar c)
+{
+    if (c == '@') return EZFormEmailCharacterClassAt;
+    if (c == '.') return EZFormEmailCharacterClassDot;
+    return EZFormEmailCharacterClassOther;
+}
+
 
 #pragma mark - Input Validation functions
 
@@ -79,37 +150,24 @@ EZFormValidateEmailFormat(NSString *value)
 	return NO;
     }
     
-    // Check for "@" char within string, but not at either end
-    NSRange range = [value rangeOfString:@"@"];
-    if (range.location == NSNotFound || range.location < 1 || range.location >= [value length]-1) {
-	return NO;
-    }
-    
-    // Check for multiple "@" chars
-    NSRange range2 = [value rangeOfString:@"@" options:NSBackwardsSearch];
-    if (range2.location != range.location) {
-	return NO;
-    }
-    
-    NSString *domain = [value componentsSeparatedByString:@"@"][1];
-    
-    if ([domain length] < 3) {
-	return NO;
-    }
+    CFStringRef string = (__bridge CFStringRef)value;
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
     
-    // Check for "." char within domain, but not the first character
-    range = [domain rangeOfString:@"."];
-    if (range.location == NSNotFound || range.location < 1) {
-	return NO;
-    }
-    
-    // Check for ".." char within domain
-    range = [domain rangeOfString:@".."];
-    if (range.location != NSNotFound) {
-	return NO;
+    EZFormEmailScanState state = EZFormEmailScanStateStart;
+    CFIndex atIndex = 0;
+    for (CFIndex i=0; i < length && state != EZFormEmailScanStateReject; i++) {
+	UniChar c = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+	state = EZFormEmailFormatTransitions[state][EZFormEmailCharacterClassForCharacter(c)];
+	if (state == EZFormEmailScanStateDomainStart) {
+	    atIndex = i;
+	}
     }
     
-    return YES;
+    // Domain must contain a "." and be at least 3 characters long
+    BOOL domainHasDot = (state == EZFormEmailScanStateDomainDot || state == EZFormEmailScanStateDomainDotted);
+    return (domainHasDot && (length - atIndex - 1) >= 3);
 }
 
 
@@ -124,27 +182,21 @@ EZFormFilterInputForEmailAddressFormat(NSString *input)
      * Prevents consecutive "." characters in domain part.
      */
     
-    NSRange range = [input rangeOfString:@"@"];
-    if (range.location != NSNotFound) {
-	
-	// Check for multiple "@" chars
-	NSRange range2 = [input rangeOfString:@"@" options:NSBackwardsSearch];
-	if (range2.location != range.location) {
-	    return NO;
-	}
-	
-	NSString *domain = [input componentsSeparatedByString:@"@"][1];
-	
-	range = [domain rangeOfString:@"."];
-	if (range.location != NSNotFound) {
-	    
-	    // Check for ".." char within domain
-	    range = [domain rangeOfString:@".."];
-	    if (range.location != NSNotFound) {
-		return NO;
-	    }
-	}
+    if (nil == input) {
+	// nil input has always been rejected
+	return NO;
     }
     
-    return YES;
+    CFStringRef string = (__bridge CFStringRef)input;
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    
+    EZFormEmailScanState state = EZFormEmailScanStateLocal;
+    for (CFIndex i=0; i < length && state != EZFormEmailScanStateReject; i++) {
+	UniChar c = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+	state = EZFormEmailInputFilterTransitions[state][EZFormEmailCharacterClassForCharacter(c)];
+    }
+    
+    return (state != EZFormEmailScanStateReject);
 }
@@ -0,0 +1,81 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "EZFormGenericField.h"
+
+
+/** A read-only form field whose value is computed from other fields.
+ *
+ *  The value is the result of a computation block, given the model
+ *  values of the fields named by inputKeys. It is computed when first
+ *  read and remembered. It is only computed again when read after the
+ *  valueVersion of an input field has changed, or a different field has
+ *  taken an input key. Computed fields can be inputs of other computed
+ *  fields.
+ *
+ *  Computed values appear in modelValues and snapshots like any other
+ *  field. A wired label is updated whenever an input changes. Setting
+ *  the field or model value of a computed field is ignored, so model
+ *  values read from a form can be restored into it unchanged.
+ *
+ *  The input keys are also the validationDependencyKeys of the field,
+ *  so the field and any fields depending on it are revalidated when an
+ *  input changes.
+ */
+@interface EZFormComputedField : EZFormGenericField
+
+/** Creates a computed field.
+ *
+ *  @param aKey The key of the field.
+ *
+ *  @param inputKeys The keys of the fields the value is computed from.
+ *
+ *  @param computation A block returning the computed value. It is given
+ *  the model values of the input fields by key, without the inputs
+ *  whose value is nil.
+ *
+ *  @returns A computed field.
+ */
++ (instancetype)computedFieldWithKey:(NSString *)aKey inputKeys:(NSArray *)inputKeys computation:(id (^)(NSDictionary *inputValues))computation;
+
+/** Initializes a computed field.
+ *
+ *  See computedFieldWithKey:inputKeys:computation:.
+ */
+- (instancetype)initWithKey:(NSString *)aKey inputKeys:(NSArray *)inputKeys computation:(id (^)(NSDictionary *inputValues))computation NS_DESIGNATED_INITIALIZER;
+
+/** The keys of the fields the value is computed from.
+ */
+@property (nonatomic, readonly, copy) NSArray *inputKeys;
+
+/** Discards the remembered value, so it is computed again the next time
+ *  it is read.
+ *
+ *  Call if the computation depends on anything other than the input
+ *  field values.
+ */
+- (void)setNeedsComputation;
+
+@end
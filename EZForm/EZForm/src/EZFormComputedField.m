@@ -0,0 +1,198 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormComputedField.h"
+#import "EZForm+Private.h"
+#import "EZFormField+Private.h"
+
+
+#pragma mark - EZFormComputedField class extension
+
+@interface EZFormComputedField () {
+    BOOL hasComputedValue;
+    id computedValue;
+    NSPointerArray *computedInputFields;	// weak, the input fields computedValue was computed from
+    NSArray *computedInputVersions;		// their valueVersions at the time
+}
+
+@property (nonatomic, readwrite, copy) NSArray *inputKeys;
+@property (nonatomic, copy) id (^computation)(NSDictionary *inputValues);
+
+@end
+
+
+#pragma mark - EZFormComputedField implementation
+
+@implementation EZFormComputedField
+
++ (instancetype)computedFieldWithKey:(NSString *)aKey inputKeys:(NSArray *)inputKeys computation:(id (^)(NSDictionary *inputValues))computation
+{
+    return [[self alloc] initWithKey:aKey inputKeys:inputKeys computation:computation];
+}
+
+- (void)setNeedsComputation
+{
+    hasComputedValue = NO;
+    [self fieldValueDidChange];
+}
+
+
+#pragma mark - Computation
+
+/* The remembered value is current if every input key still names the
+ * same field, at the same valueVersion. Computed inputs are brought up
+ * to date first, so their versions reflect their own inputs.
+ */
+- (BOOL)needsComputation
+{
+    if (!hasComputedValue) {
+	return YES;
+    }
+    
+    __strong EZForm *form = self.form;
+    NSArray *inputKeys = self.inputKeys;
+    NSUInteger count = [inputKeys count];
+    for (NSUInteger i=0; i < count; i++) {
+	EZFormField *inputField = [form formFieldForKey:inputKeys[i]];
+	if ([inputField isKindOfClass:[EZFormComputedField class]]) {
+	    [(EZFormComputedField *)inputField computeIfNeeded];
+	}
+	
+	if (inputField != [computedInputFields pointerAtIndex:i]) {
+	    return YES;
+	}
+	if (inputField && inputField.valueVersion != [computedInputVersions[i] unsignedIntegerValue]) {
+	    return YES;
+	}
+    }
+    return NO;
+}
+
+- (void)computeIfNeeded
+{
+    if (![self needsComputation]) {
+	return;
+    }
+    
+    __strong EZForm *form = self.form;
+    NSArray *inputKeys = self.inputKeys;
+    NSMutableDictionary *inputValues = [NSMutableDictionary dictionaryWithCapacity:[inputKeys count]];
+    NSPointerArray *inputFields = [NSPointerArray weakObjectsPointerArray];
+    NSMutableArray *inputVersions = [NSMutableArray arrayWithCapacity:[inputKeys count]];
+    for (NSString *inputKey in inputKeys) {
+	EZFormField *inputField = [form formFieldForKey:inputKey];
+	[inputValues setValue:inputField.modelValue forKey:inputKey];
+	[inputFields addPointer:(__bridge void *)inputField];
+	[inputVersions addObject:@(inputField.valueVersion)];
+    }
+    
+    id value = (self.computation ? self.computation(inputValues) : nil);
+    
+    computedInputFields = inputFields;
+    computedInputVersions = inputVersions;
+    hasComputedValue = YES;
+    
+    // Fields computed from this one only recompute if the value changed
+    if (value != computedValue && ![value isEqual:computedValue]) {
+	computedValue = value;
+	self.valueVersion += 1;
+	[self setNeedsValidation];
+    }
+}
+
+/* Called by the form when an input field changes. The value itself is
+ * computed when next read; only a wired view needs it right away.
+ */
+- (void)inputValuesDidChange
+{
+    __strong EZForm *form = self.form;
+    if (self.userView && ![form deferViewUpdateForFormField:self]) {
+	[self performUpdateView];
+    }
+}
+
+
+#pragma mark - EZFormField methods
+
+- (id)actualFieldValue
+{
+    [self computeIfNeeded];
+    return computedValue;
+}
+
+- (void)setActualFieldValue:(id)value
+{
+    #pragma unused(value)
+    
+    // Read-only
+}
+
+- (void)setFieldValue:(id)value canUpdateView:(BOOL)canUpdateView
+{
+    #pragma unused(value, canUpdateView)
+    
+    // Read-only
+}
+
+- (id)modelValue
+{
+    [self computeIfNeeded];
+    return [super modelValue];
+}
+
+- (void)setModelValue:(id)modelValue canUpdateView:(BOOL)canUpdateView
+{
+    #pragma unused(modelValue, canUpdateView)
+    
+    // Read-only
+}
+
+- (void)setValidationDependencyKeys:(NSArray *)validationDependencyKeys
+{
+    // The input keys are always dependencies
+    NSMutableOrderedSet *keys = [NSMutableOrderedSet orderedSetWithArray:self.inputKeys];
+    [keys addObjectsFromArray:validationDependencyKeys];
+    [super setValidationDependencyKeys:[keys array]];
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithKey:(NSString *)aKey inputKeys:(NSArray *)inputKeys computation:(id (^)(NSDictionary *inputValues))computation
+{
+    if ((self = [super initWithKey:aKey])) {
+	_inputKeys = [inputKeys copy];
+	_computation = [computation copy];
+	self.validationDependencyKeys = nil;
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithKey:(NSString *)aKey
+{
+    return [self initWithKey:aKey inputKeys:nil computation:nil];
+}
+
+@end
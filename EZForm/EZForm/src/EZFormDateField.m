@@ -126,18 +126,25 @@
     }
 }
 
-#pragma mark - Object lifecycle
-
-- (instancetype)initWithKey:(NSString *)aKey {
-    self = [super initWithKey: aKey];
-    if (self) {
-        // Default date formatters        
-        self.inDateFormatter = [NSDateFormatter new];
-        [self.inDateFormatter setDateFormat: @"yyyy-MM-dd hh:mm a"];
-        self.outDateFormatter = [NSDateFormatter new];
-        [self.outDateFormatter setDateFormat: @"yyyy-MM-dd hh:mm a"];
+#pragma mark - Date formatters
+
+/* The default date formatters are only created when first used, as
+ * forms made from a template assign shared ones instead.
+ */
+- (NSDateFormatter *)inDateFormatter {
+    if (nil == _inDateFormatter) {
+        _inDateFormatter = [NSDateFormatter new];
+        [_inDateFormatter setDateFormat: @"yyyy-MM-dd hh:mm a"];
     }
-    return self;
+    return _inDateFormatter;
+}
+
+- (NSDateFormatter *)outDateFormatter {
+    if (nil == _outDateFormatter) {
+        _outDateFormatter = [NSDateFormatter new];
+        [_outDateFormatter setDateFormat: @"yyyy-MM-dd hh:mm a"];
+    }
+    return _outDateFormatter;
 }
 
 #pragma mark - UIDatePicker
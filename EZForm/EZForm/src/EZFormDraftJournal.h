@@ -0,0 +1,151 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@class EZForm;
+
+
+/** An append-only journal of form model value changes, for crash-safe
+ *  autosave of drafts.
+ *
+ *  Assign a journal to the draftJournal property of an EZForm and every
+ *  field value change is appended to the journal file as a small record
+ *  holding the field key and its new model value, instead of rewriting
+ *  the whole form. Records are written straight away and flushed to
+ *  storage with fsync at most once per synchronizationInterval, so at
+ *  worst the changes of that interval are lost on power failure, and
+ *  none on an app crash.
+ *
+ *  A change to a string value is recorded as the replaced range and the
+ *  replacement text, so a keystroke in a long text field writes a few
+ *  bytes rather than the whole text.
+ *
+ *  When the file grows to twice the size of its live records (and past
+ *  compactionThreshold) it is rewritten with only the latest value of
+ *  each field, with string edits merged in, in the background. Each record is checksummed, and a
+ *  record torn by a crash is discarded when the journal is opened.
+ *
+ *  Model values must be property list objects (strings, numbers, dates,
+ *  data, arrays and dictionaries of them). Other values are not journaled.
+ *
+ *  Writes happen on a private serial queue; the journal's methods should
+ *  be called on the main thread, like the form's.
+ */
+@interface EZFormDraftJournal : NSObject
+
+/** Opens, or creates, a journal file.
+ *
+ *  @param path The path of the journal file.
+ *
+ *  @param error On return, an error if the file could not be opened.
+ *
+ *  @returns An EZFormDraftJournal object, or nil on error.
+ */
++ (instancetype)draftJournalWithPath:(NSString *)path error:(NSError **)error;
+
+/** Initialises a journal by opening, or creating, a journal file.
+ *
+ *  Any existing records are read, so they can be restored with
+ *  restoreForm: and are kept when the file is compacted.
+ *
+ *  @param path The path of the journal file.
+ *
+ *  @param error On return, an error if the file could not be opened.
+ *
+ *  @returns Initialised EZFormDraftJournal object, or nil on error.
+ */
+- (instancetype)initWithPath:(NSString *)path error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+
+/** The path of the journal file.
+ */
+@property (nonatomic, readonly, copy) NSString *path;
+
+/** Maximum time written records can wait to be flushed with fsync, in
+ *  seconds.
+ *
+ *  Default is 1 second.
+ */
+@property (nonatomic, assign) NSTimeInterval synchronizationInterval;
+
+/** File size in bytes below which the journal is never compacted.
+ *
+ *  Default is 64KB.
+ */
+@property (nonatomic, assign) unsigned long long compactionThreshold;
+
+/** The latest journaled model value of every field, keyed by field key.
+ *
+ *  Kept in memory on the main thread, so reading it never waits for
+ *  the journal file.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *modelValues;
+
+/** The error of the last failed write, compaction or flush, if any.
+ *
+ *  Errors happen on the journal's queue and are set here on the main
+ *  queue shortly after.
+ */
+@property (nonatomic, readonly, strong) NSError *lastError;
+
+/** Appends a model value change to the journal.
+ *
+ *  Called by EZForm for every field value change; can also be called
+ *  directly. The value is copied and then encoded on the journal's
+ *  queue, so the call stays cheap on the main thread. Values that are
+ *  not property lists are not journaled.
+ *
+ *  @param value The new model value, or nil if the field has no value.
+ *
+ *  @param key The field key.
+ */
+- (void)appendModelValue:(id)value forKey:(NSString *)key;
+
+/** Sets the journaled model values on a form.
+ *
+ *  The values are set with -[EZForm setModelValues:], so the form is
+ *  validated and its delegate notified once. They are not journaled again.
+ *  Fields without a value in the journal are left unchanged.
+ *
+ *  @param form The form to restore.
+ */
+- (void)restoreForm:(EZForm *)form;
+
+/** Waits until every appended record is written and flushed to storage.
+ *
+ *  Blocks the calling thread; the other methods never wait for the
+ *  journal file.
+ */
+- (void)synchronize;
+
+/** Rewrites the journal file with only the latest record of each field,
+ *  in the background.
+ */
+- (void)compact;
+
+/** Discards all records, for example once the draft has been submitted.
+ */
+- (void)removeAllModelValues;
+
+@end
@@ -0,0 +1,596 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <fcntl.h>
+#import <unistd.h>
+#import <sys/stat.h>
+#import "EZFormDraftJournal.h"
+#import "EZForm.h"
+
+/* Journal file layout, all integers little endian:
+ *
+ *   header:  "EZFJ" uint32 version
+ *   record:  uint32 payload length, uint32 payload checksum, payload
+ *   payload: uint8 type, uint32 key length, key (UTF-8), body
+ *
+ * The body of a set record is a binary property list. Remove records,
+ * for fields without a value, have no body. Edit records change the
+ * string value of a field in place, so typing in a long text writes
+ * only what was typed; their body is a uint32 location and uint32
+ * length of the replaced UTF-16 range, followed by the replacement
+ * string (UTF-8). Edits are merged into set records on compaction.
+ *
+ * Version 1 journals have no edit records.
+ */
+static const char EZFormDraftJournalMagic[4] = {'E', 'Z', 'F', 'J'};
+static const uint32_t EZFormDraftJournalVersion = 2;
+
+#define EZFormDraftJournalHeaderLength 8
+#define EZFormDraftJournalRecordHeaderLength 8
+#define EZFormDraftJournalPayloadHeaderLength 5
+#define EZFormDraftJournalEditHeaderLength 8
+
+typedef NS_ENUM(uint8_t, EZFormDraftJournalRecordType) {
+    EZFormDraftJournalRecordTypeSet = 1,
+    EZFormDraftJournalRecordTypeRemove = 2,
+    EZFormDraftJournalRecordTypeEdit = 3,
+} ;
+
+
+#pragma mark - Record encoding
+
+/* 32-bit FNV-1a, to detect records torn by a crash. */
+static uint32_t
+EZFormDraftJournalChecksum(const uint8_t *bytes, NSUInteger length)
+{
+    uint32_t hash = 2166136261u;
+    for (NSUInteger i=0; i < length; i++) {
+	hash ^= bytes[i];
+	hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void
+EZFormDraftJournalAppendUInt32(NSMutableData *data, uint32_t value)
+{
+    uint32_t littleEndianValue = CFSwapInt32HostToLittle(value);
+    [data appendBytes:&littleEndianValue length:sizeof(littleEndianValue)];
+}
+
+static uint32_t
+EZFormDraftJournalReadUInt32(const uint8_t *bytes)
+{
+    uint32_t littleEndianValue;
+    memcpy(&littleEndianValue, bytes, sizeof(littleEndianValue));
+    return CFSwapInt32LittleToHost(littleEndianValue);
+}
+
+static NSData *
+EZFormDraftJournalHeaderData(void)
+{
+    NSMutableData *data = [NSMutableData dataWithBytes:EZFormDraftJournalMagic length:sizeof(EZFormDraftJournalMagic)];
+    EZFormDraftJournalAppendUInt32(data, EZFormDraftJournalVersion);
+    return data;
+}
+
+static NSData *
+EZFormDraftJournalRecordData(EZFormDraftJournalRecordType type, NSString *key, NSData *bodyData)
+{
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableData *payload = [NSMutableData dataWithCapacity:EZFormDraftJournalPayloadHeaderLength + [keyData length] + [bodyData length]];
+    [payload appendBytes:&type length:sizeof(type)];
+    EZFormDraftJournalAppendUInt32(payload, (uint32_t)[keyData length]);
+    [payload appendData:keyData];
+    if (bodyData) {
+	[payload appendData:bodyData];
+    }
+    
+    NSMutableData *record = [NSMutableData dataWithCapacity:EZFormDraftJournalRecordHeaderLength + [payload length]];
+    EZFormDraftJournalAppendUInt32(record, (uint32_t)[payload length]);
+    EZFormDraftJournalAppendUInt32(record, EZFormDraftJournalChecksum([payload bytes], [payload length]));
+    [record appendData:payload];
+    return record;
+}
+
+/* Returns a set record for value, or a remove record for nil. Returns nil
+ * if value is not a property list.
+ */
+static NSData *
+EZFormDraftJournalValueRecordData(NSString *key, id value)
+{
+    if (nil == value) {
+	return EZFormDraftJournalRecordData(EZFormDraftJournalRecordTypeRemove, key, nil);
+    }
+    
+    NSData *valueData = [NSPropertyListSerialization dataWithPropertyList:value format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+    return (valueData ? EZFormDraftJournalRecordData(EZFormDraftJournalRecordTypeSet, key, valueData) : nil);
+}
+
+/* Returns an edit record turning string into newString, by replacing the
+ * characters between their common prefix and suffix. Returns nil if the
+ * replacement is too large for an edit to be worth it.
+ */
+static NSData *
+EZFormDraftJournalEditRecordData(NSString *key, NSString *string, NSString *newString)
+{
+    NSUInteger length = [string length];
+    NSUInteger newLength = [newString length];
+    NSUInteger maxCommonLength = MIN(length, newLength);
+    
+    CFStringInlineBuffer buffer;
+    CFStringInlineBuffer newBuffer;
+    CFStringInitInlineBuffer((__bridge CFStringRef)string, &buffer, CFRangeMake(0, (CFIndex)length));
+    CFStringInitInlineBuffer((__bridge CFStringRef)newString, &newBuffer, CFRangeMake(0, (CFIndex)newLength));
+    
+    NSUInteger prefixLength = 0;
+    while (prefixLength < maxCommonLength && CFStringGetCharacterFromInlineBuffer(&buffer, (CFIndex)prefixLength) == CFStringGetCharacterFromInlineBuffer(&newBuffer, (CFIndex)prefixLength)) {
+	prefixLength++;
+    }
+    NSUInteger suffixLength = 0;
+    while (suffixLength < maxCommonLength - prefixLength && CFStringGetCharacterFromInlineBuffer(&buffer, (CFIndex)(length - suffixLength - 1)) == CFStringGetCharacterFromInlineBuffer(&newBuffer, (CFIndex)(newLength - suffixLength - 1))) {
+	suffixLength++;
+    }
+    
+    // Never split a surrogate pair
+    if (prefixLength > 0 && CFStringIsSurrogateHighCharacter(CFStringGetCharacterFromInlineBuffer(&newBuffer, (CFIndex)(prefixLength - 1)))) {
+	prefixLength--;
+    }
+    if (suffixLength > 0 && CFStringIsSurrogateLowCharacter(CFStringGetCharacterFromInlineBuffer(&newBuffer, (CFIndex)(newLength - suffixLength)))) {
+	suffixLength--;
+    }
+    
+    NSRange replacedRange = NSMakeRange(prefixLength, length - prefixLength - suffixLength);
+    NSRange replacementRange = NSMakeRange(prefixLength, newLength - prefixLength - suffixLength);
+    if (replacementRange.length > newLength / 2 || length > UINT32_MAX) {
+	return nil;
+    }
+    
+    NSData *replacementData = [[newString substringWithRange:replacementRange] dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableData *bodyData = [NSMutableData dataWithCapacity:EZFormDraftJournalEditHeaderLength + [replacementData length]];
+    EZFormDraftJournalAppendUInt32(bodyData, (uint32_t)replacedRange.location);
+    EZFormDraftJournalAppendUInt32(bodyData, (uint32_t)replacedRange.length);
+    [bodyData appendData:replacementData];
+    return EZFormDraftJournalRecordData(EZFormDraftJournalRecordTypeEdit, key, bodyData);
+}
+
+/* Applies the body of an edit record to string. Returns NO if the edit
+ * does not fit the string.
+ */
+static BOOL
+EZFormDraftJournalApplyEdit(NSMutableString *string, NSData *bodyData)
+{
+    if ([bodyData length] < EZFormDraftJournalEditHeaderLength) {
+	return NO;
+    }
+    
+    const uint8_t *bytes = [bodyData bytes];
+    NSRange replacedRange = NSMakeRange(EZFormDraftJournalReadUInt32(bytes), EZFormDraftJournalReadUInt32(bytes + 4));
+    if (replacedRange.location > [string length] || replacedRange.length > [string length] - replacedRange.location) {
+	return NO;
+    }
+    
+    NSString *replacement = [[NSString alloc] initWithBytes:bytes + EZFormDraftJournalEditHeaderLength length:[bodyData length] - EZFormDraftJournalEditHeaderLength encoding:NSUTF8StringEncoding];
+    if (nil == replacement) {
+	return NO;
+    }
+    [string replaceCharactersInRange:replacedRange withString:replacement];
+    return YES;
+}
+
+/* Calls block with the type, key, body data (nil for remove records) and
+ * range of each valid record in data, from offset on, until the block
+ * returns NO. Returns the length of the records accepted; anything after
+ * them is a torn or corrupt write.
+ */
+static NSUInteger
+EZFormDraftJournalEnumerateRecords(NSData *data, NSUInteger offset, BOOL (^block)(EZFormDraftJournalRecordType type, NSString *key, NSData *bodyData, NSRange recordRange))
+{
+    const uint8_t *bytes = [data bytes];
+    NSUInteger length = [data length];
+    
+    while (length - offset >= EZFormDraftJournalRecordHeaderLength) {
+	NSUInteger payloadLength = EZFormDraftJournalReadUInt32(bytes + offset);
+	uint32_t checksum = EZFormDraftJournalReadUInt32(bytes + offset + 4);
+	NSUInteger payloadOffset = offset + EZFormDraftJournalRecordHeaderLength;
+	if (payloadLength < EZFormDraftJournalPayloadHeaderLength || length - payloadOffset < payloadLength) break;
+	
+	const uint8_t *payload = bytes + payloadOffset;
+	if (EZFormDraftJournalChecksum(payload, payloadLength) != checksum) break;
+	
+	uint8_t type = payload[0];
+	NSUInteger keyLength = EZFormDraftJournalReadUInt32(payload + 1);
+	if (keyLength > payloadLength - EZFormDraftJournalPayloadHeaderLength) break;
+	if (type != EZFormDraftJournalRecordTypeSet && type != EZFormDraftJournalRecordTypeRemove && type != EZFormDraftJournalRecordTypeEdit) break;
+	
+	NSString *key = [[NSString alloc] initWithBytes:payload + EZFormDraftJournalPayloadHeaderLength length:keyLength encoding:NSUTF8StringEncoding];
+	if (nil == key) break;
+	
+	NSData *bodyData = nil;
+	if (type != EZFormDraftJournalRecordTypeRemove) {
+	    NSUInteger bodyOffset = payloadOffset + EZFormDraftJournalPayloadHeaderLength + keyLength;
+	    bodyData = [data subdataWithRange:NSMakeRange(bodyOffset, payloadOffset + payloadLength - bodyOffset)];
+	}
+	
+	NSUInteger recordLength = EZFormDraftJournalRecordHeaderLength + payloadLength;
+	if (!block((EZFormDraftJournalRecordType)type, key, bodyData, NSMakeRange(offset, recordLength))) break;
+	offset += recordLength;
+    }
+    
+    return offset;
+}
+
+static BOOL
+EZFormDraftJournalWrite(int fd, NSData *data)
+{
+    const uint8_t *bytes = [data bytes];
+    NSUInteger remaining = [data length];
+    while (remaining > 0) {
+	ssize_t written = write(fd, bytes, remaining);
+	if (written < 0) {
+	    if (errno == EINTR) continue;
+	    return NO;
+	}
+	bytes += written;
+	remaining -= (NSUInteger)written;
+    }
+    return YES;
+}
+
+static NSError *
+EZFormDraftJournalPOSIXError(NSString *path)
+{
+    return [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey: path}];
+}
+
+
+#pragma mark - EZFormDraftJournal class extension
+
+@interface EZFormDraftJournal () {
+    // Only accessed on the journal queue
+    int _fd;
+    unsigned long long _fileSize;
+    unsigned long long _liveSize;	// header and latest record of each key
+    BOOL _synchronizationScheduled;
+    
+    // Only accessed on the main thread
+    BOOL _restoring;
+}
+
+@property (nonatomic, readwrite, copy) NSString *path;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableDictionary *records;	// key -> latest set or remove record data, journal queue only
+@property (nonatomic, strong) NSMutableSet *editedKeys;		// keys edited since their record, journal queue only
+@property (nonatomic, strong) NSMutableDictionary *values;	// key -> latest value or NSNull, journal queue only
+@property (nonatomic, strong) NSMutableDictionary *latestValues;	// key -> latest value or NSNull, main thread only
+@property (nonatomic, readwrite, strong) NSError *lastError;	// main thread only
+
+@end
+
+
+#pragma mark - EZFormDraftJournal implementation
+
+@implementation EZFormDraftJournal
+
++ (instancetype)draftJournalWithPath:(NSString *)path error:(NSError **)error
+{
+    return [[self alloc] initWithPath:path error:error];
+}
+
+/* The latest values are kept on the main thread as well as written by
+ * the journal queue, so reading them never waits for a write, flush or
+ * compaction in progress.
+ */
+- (NSDictionary *)modelValues
+{
+    NSMutableDictionary *modelValues = [self.latestValues mutableCopy];
+    [modelValues removeObjectsForKeys:[modelValues allKeysForObject:[NSNull null]]];
+    return modelValues;
+}
+
+- (void)appendModelValue:(id)value forKey:(NSString *)key
+{
+    if (_restoring || nil == key) return;
+    
+    // Copied here, as the value may be mutated once this returns, then
+    // encoded on the journal queue to keep serialization off the caller's
+    // thread. Copying an immutable value just retains it.
+    id valueCopy = ([value conformsToProtocol:@protocol(NSCopying)] ? [value copy] : value);
+    if (valueCopy && ![NSPropertyListSerialization propertyList:valueCopy isValidForFormat:NSPropertyListBinaryFormat_v1_0]) {
+	return;
+    }
+    NSString *keyCopy = [key copy];
+    self.latestValues[keyCopy] = (valueCopy ?: [NSNull null]);
+    
+    dispatch_async(self.queue, ^{
+	id previousValue = self.values[keyCopy];
+	if (previousValue == valueCopy || [previousValue isEqual:valueCopy]) {
+	    return;
+	}
+	self.values[keyCopy] = (valueCopy ?: [NSNull null]);
+	
+	if ([valueCopy isKindOfClass:[NSString class]] && [previousValue isKindOfClass:[NSString class]]) {
+	    NSData *editRecord = EZFormDraftJournalEditRecordData(keyCopy, previousValue, valueCopy);
+	    if (editRecord) {
+		[self writeRecord:editRecord forKey:keyCopy isEdit:YES];
+		return;
+	    }
+	}
+	
+	NSData *record = EZFormDraftJournalValueRecordData(keyCopy, valueCopy);
+	if (record) {
+	    [self writeRecord:record forKey:keyCopy isEdit:NO];
+	}
+    });
+}
+
+- (void)restoreForm:(EZForm *)form
+{
+    NSDictionary *latestValues = [self.latestValues copy];
+    
+    _restoring = YES;
+    [form beginUpdates];
+    @try {
+	for (NSString *key in latestValues) {
+	    id value = latestValues[key];
+	    [form setModelValue:(value == [NSNull null] ? nil : value) forKey:key];
+	}
+    }
+    @finally {
+	[form endUpdates];
+	_restoring = NO;
+    }
+}
+
+- (void)synchronize
+{
+    dispatch_sync(self.queue, ^{
+	[self synchronizeOnQueue];
+    });
+}
+
+- (void)compact
+{
+    dispatch_async(self.queue, ^{
+	[self compactOnQueue];
+    });
+}
+
+- (void)removeAllModelValues
+{
+    [self.latestValues removeAllObjects];
+    dispatch_async(self.queue, ^{
+	[self.records removeAllObjects];
+	[self.editedKeys removeAllObjects];
+	[self.values removeAllObjects];
+	[self compactOnQueue];
+    });
+}
+
+
+#pragma mark - Journal queue
+
+- (void)reportError:(NSError *)error
+{
+    dispatch_async(dispatch_get_main_queue(), ^{
+	self.lastError = error;
+    });
+}
+
+/* Appends a record. Edit records leave the key's last full record in
+ * place, to be replaced by the merged value on compaction, and do not
+ * count towards the live size.
+ */
+- (void)writeRecord:(NSData *)record forKey:(NSString *)key isEdit:(BOOL)isEdit
+{
+    if (_fd < 0) return;
+    
+    if (!EZFormDraftJournalWrite(_fd, record)) {
+	[self reportError:EZFormDraftJournalPOSIXError(self.path)];
+	return;
+    }
+    _fileSize += [record length];
+    
+    if (isEdit) {
+	[self.editedKeys addObject:key];
+    }
+    else {
+	NSData *previousRecord = self.records[key];
+	_liveSize = _liveSize - [previousRecord length] + [record length];
+	self.records[key] = record;
+	[self.editedKeys removeObject:key];
+    }
+    
+    if (!_synchronizationScheduled) {
+	_synchronizationScheduled = YES;
+	dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.synchronizationInterval * NSEC_PER_SEC)), self.queue, ^{
+	    [self synchronizeOnQueue];
+	});
+    }
+    
+    if (_fileSize > self.compactionThreshold && _fileSize > 2 * _liveSize) {
+	[self compactOnQueue];
+    }
+}
+
+- (void)synchronizeOnQueue
+{
+    _synchronizationScheduled = NO;
+    if (_fd >= 0 && fsync(_fd) != 0) {
+	[self reportError:EZFormDraftJournalPOSIXError(self.path)];
+    }
+}
+
+/* Writes the latest records to a new file, flushes it and renames it
+ * over the journal, so a crash during compaction leaves either the old
+ * or the new journal intact.
+ */
+- (void)compactOnQueue
+{
+    NSString *compactionPath = [self.path stringByAppendingString:@".compact"];
+    int fd = open([compactionPath fileSystemRepresentation], O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+	[self reportError:EZFormDraftJournalPOSIXError(compactionPath)];
+	return;
+    }
+    
+    // Merge the edits of each edited key into a full record
+    for (NSString *key in self.editedKeys) {
+	NSData *record = EZFormDraftJournalValueRecordData(key, self.values[key]);
+	if (record) {
+	    self.records[key] = record;
+	}
+    }
+    [self.editedKeys removeAllObjects];
+    
+    NSMutableData *data = [EZFormDraftJournalHeaderData() mutableCopy];
+    for (NSData *record in [self.records objectEnumerator]) {
+	[data appendData:record];
+    }
+    
+    if (!EZFormDraftJournalWrite(fd, data) || fsync(fd) != 0 || rename([compactionPath fileSystemRepresentation], [self.path fileSystemRepresentation]) != 0) {
+	[self reportError:EZFormDraftJournalPOSIXError(compactionPath)];
+	close(fd);
+	unlink([compactionPath fileSystemRepresentation]);
+	return;
+    }
+    close(fd);
+    
+    if (_fd >= 0) {
+	close(_fd);
+    }
+    _fd = open([self.path fileSystemRepresentation], O_WRONLY | O_APPEND);
+    if (_fd < 0) {
+	[self reportError:EZFormDraftJournalPOSIXError(self.path)];
+    }
+    _fileSize = [data length];
+    _liveSize = [data length];
+    _synchronizationScheduled = NO;
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithPath:(NSString *)path error:(NSError **)error
+{
+    if ((self = [super init])) {
+	self.path = path;
+	self.queue = dispatch_queue_create("EZFormDraftJournal", DISPATCH_QUEUE_SERIAL);
+	self.records = [NSMutableDictionary dictionary];
+	self.editedKeys = [NSMutableSet set];
+	self.latestValues = [NSMutableDictionary dictionary];
+	_synchronizationInterval = 1.0;
+	_compactionThreshold = 64 * 1024;
+	
+	_fd = open([path fileSystemRepresentation], O_RDWR | O_CREAT | O_APPEND, 0600);
+	if (_fd < 0) {
+	    if (error) *error = EZFormDraftJournalPOSIXError(path);
+	    return nil;
+	}
+	
+	NSData *data = [NSData dataWithContentsOfFile:path options:0 error:NULL];
+	NSData *headerData = EZFormDraftJournalHeaderData();
+	NSUInteger validLength = 0;
+	uint32_t version = 0;
+	if ([data length] >= EZFormDraftJournalHeaderLength && memcmp([data bytes], EZFormDraftJournalMagic, sizeof(EZFormDraftJournalMagic)) == 0) {
+	    version = EZFormDraftJournalReadUInt32((const uint8_t *)[data bytes] + sizeof(EZFormDraftJournalMagic));
+	}
+	if (version >= 1 && version <= EZFormDraftJournalVersion) {
+	    NSMutableDictionary *records = self.records;
+	    NSMutableSet *editedKeys = self.editedKeys;
+	    NSMutableDictionary *latestValues = self.latestValues;
+	    validLength = EZFormDraftJournalEnumerateRecords(data, EZFormDraftJournalHeaderLength, ^BOOL(EZFormDraftJournalRecordType type, NSString *key, NSData *bodyData, NSRange recordRange) {
+		switch (type) {
+		    case EZFormDraftJournalRecordTypeSet:
+		    case EZFormDraftJournalRecordTypeRemove: {
+			id value = (bodyData ? [NSPropertyListSerialization propertyListWithData:bodyData options:NSPropertyListImmutable format:NULL error:NULL] : nil);
+			latestValues[key] = (value ?: [NSNull null]);
+			records[key] = [data subdataWithRange:recordRange];
+			[editedKeys removeObject:key];
+			return YES;
+		    }
+		    case EZFormDraftJournalRecordTypeEdit: {
+			id value = latestValues[key];
+			if (![value isKindOfClass:[NSString class]]) return NO;
+			NSMutableString *string = ([editedKeys containsObject:key] ? value : [value mutableCopy]);
+			if (!EZFormDraftJournalApplyEdit(string, bodyData)) return NO;
+			latestValues[key] = string;
+			[editedKeys addObject:key];
+			return YES;
+		    }
+		}
+		return NO;
+	    });
+	    
+	    // Edited strings were built up in place
+	    for (NSString *key in editedKeys) {
+		latestValues[key] = [latestValues[key] copy];
+	    }
+	}
+	
+	// Drop a torn last record, or start afresh over a foreign or empty file
+	if (validLength == 0) {
+	    if (ftruncate(_fd, 0) != 0 || !EZFormDraftJournalWrite(_fd, headerData)) {
+		if (error) *error = EZFormDraftJournalPOSIXError(path);
+		close(_fd);
+		return nil;
+	    }
+	    validLength = EZFormDraftJournalHeaderLength;
+	}
+	else if (validLength < [data length] && ftruncate(_fd, (off_t)validLength) != 0) {
+	    if (error) *error = EZFormDraftJournalPOSIXError(path);
+	    close(_fd);
+	    return nil;
+	}
+	
+	_fileSize = validLength;
+	_liveSize = EZFormDraftJournalHeaderLength;
+	for (NSData *record in [self.records objectEnumerator]) {
+	    _liveSize += [record length];
+	}
+	self.values = [self.latestValues mutableCopy];
+	
+	// Rewrite older journals in the current format before appending to them
+	if (version >= 1 && version < EZFormDraftJournalVersion) {
+	    [self compactOnQueue];
+	}
+    }
+    
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"EZFormDraftJournal"] error:NULL];
+}
+
+- (void)dealloc
+{
+    if (_fd >= 0) {
+	fsync(_fd);
+	close(_fd);
+    }
+}
+
+@end
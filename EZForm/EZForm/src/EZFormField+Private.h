@@ -29,5 +29,24 @@
 @interface EZFormField (Private)
 
 @property (nonatomic, assign, readwrite) EZForm *form;
+@property (nonatomic, assign, readwrite) NSUInteger valueVersion;
+
+- (void)performUpdateView;
+
+/* Bumps valueVersion and marks the field as needing validation. Call
+ * instead of setNeedsValidation whenever the field value changes
+ * without going through setFieldValue:canUpdateView:.
+ */
+- (void)fieldValueDidChange;
+
+/* Returns modelValue run through valueTransformer, if any, reusing the
+ * previous result when the same value is transformed again.
+ */
+- (id)transformedValueForModelValue:(id)modelValue;
+
+/* Discards cached transformer results. Call when the transformer's
+ * output would change for the same input.
+ */
+- (void)invalidateTransformedValues;
 
 @end
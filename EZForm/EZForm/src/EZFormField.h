@@ -29,6 +29,9 @@ typedef BOOL (*VALIDATOR)(id);			    // function validator
 typedef BOOL (^EZFormFieldValidator)(id value);	    // block validator
 
 @class EZForm;
+@class EZFormAsyncValidator;
+@class EZFormValidationRules;
+@class EZFormFieldValidationReport;
 
 /** Abstract base class for form fields.
  *
@@ -81,6 +84,14 @@ typedef BOOL (^EZFormFieldValidator)(id value);	    // block validator
 
 - (void)setModelValue:(id)modelValue canUpdateView:(BOOL)canUpdateView;
 
+/** A counter incremented every time the field value changes.
+ *
+ *  The reverse transformed modelValue is cached against this counter,
+ *  so valueTransformer is only asked to transform once per change. See
+ *  EZFormValueTransformer's pure property to opt out.
+ */
+@property (nonatomic, readonly) NSUInteger valueVersion;
+
 /** Set a user-defined validator function.
  *
  *  The function will be called to validate the field value and
@@ -122,10 +133,86 @@ typedef BOOL (^EZFormFieldValidator)(id value);	    // block validator
  */
 - (void)addValidator:(BOOL (^)(id value))validator;
 
+/** Declarative validation rules for the field value.
+ *
+ *  The rules are checked after any user-defined validators and the
+ *  validation function. Compiled rules are immutable and can be shared
+ *  by any number of fields, for example:
+ *
+ *	field.validationRules = [EZFormValidationRules validationRulesWithSpec:@"required|min:3|max:64"];
+ *
+ *  Set to nil to remove the rules.
+ */
+@property (nonatomic, strong) EZFormValidationRules *validationRules;
+
+/** Keys of other form fields whose values the validity of this field
+ *  depends on.
+ *
+ *  Declare the keys read by cross-field validators, such as the
+ *  password a confirmation field must match. When the value of one of
+ *  those fields changes, the form revalidates this field too, and in
+ *  turn any fields depending on it, each after its own dependencies.
+ *  Other fields keep their cached results.
+ *
+ *  Dependencies must not form a cycle. Adding a field to a form, or
+ *  setting this property on a field of a form, raises an
+ *  NSInvalidArgumentException if it would create one.
+ *
+ *  Default is nil.
+ */
+@property (nonatomic, copy) NSArray *validationDependencyKeys;
+
+/** Adds a validator that runs off the main thread.
+ *
+ *  Asynchronous validators run once the field value passes all other
+ *  validation rules. Until every asynchronous validator has reported
+ *  back, the field is treated as invalid and isValidationPending returns
+ *  YES. A validation in flight is cancelled, and its result ignored, as
+ *  soon as the field value changes again.
+ *
+ *  The form delegate is told when validation of a field becomes pending
+ *  and when it is resolved.
+ *
+ *  @param asyncValidator The asynchronous validator to add.
+ */
+- (void)addAsyncValidator:(EZFormAsyncValidator *)asyncValidator;
+
+/** Removes all asynchronous validators added by addAsyncValidator:.
+ */
+- (void)removeAsyncValidators;
+
+/** Returns a boolean indicating whether asynchronous validation of the
+ *  field value is still in progress.
+ */
+@property (nonatomic, getter=isValidationPending, readonly) BOOL validationPending;
+
 /** Returns a boolean indicating whether the field value is valid.
+ *
+ *  Returns NO while asynchronous validation is pending.
+ *
+ *  The result is cached until the field value, the value transformer
+ *  or the validation rules of the field change.
  */
 @property (nonatomic, getter=isValid, readonly) BOOL valid;
 
+/** Returns a report of the last validation of the field, recording which
+ *  validation step failed and why.
+ *
+ *  The field is validated first if needed. The report is cached along
+ *  with the validation result, so reading it again does not run any
+ *  validators.
+ */
+@property (nonatomic, readonly, strong) EZFormFieldValidationReport *validationReport;
+
+/** Discards the cached validation result of the field.
+ *
+ *  Validation results are cached until the field value or the
+ *  validation rules change. If a validator depends on any other state,
+ *  call this method when that state changes so the field is
+ *  revalidated the next time its validity is requested.
+ */
+- (void)setNeedsValidation;
+
 /** Requests the wired user control to become first responder.
  */
 - (void)becomeFirstResponder;
@@ -27,16 +27,114 @@
 #import "EZFormFieldConcreteProtocol.h"
 #import "EZForm+Private.h"
 #import "EZFormReversibleValueTransformer.h"
+#import "EZFormAsyncValidator.h"
+#import "EZFormValidationRules.h"
+#import "EZFormValidationReport.h"
+#import "EZFormInstrumentation+Private.h"
+
+typedef NS_ENUM(NSInteger, EZFormFieldValidityState) {
+    EZFormFieldValidityStateUnknown = 0,
+    EZFormFieldValidityStateValid,
+    EZFormFieldValidityStateInvalid,
+    EZFormFieldValidityStatePending,
+} ;
+
+
+#pragma mark - External Class Categories
+
+@interface EZFormFieldValidationReport (EZFormPrivateAccess)
+- (instancetype)initWithKey:(NSString *)key valueVersion:(NSUInteger)valueVersion failure:(EZFormValidationFailure)failure failedValidatorIndex:(NSUInteger)failedValidatorIndex failedRule:(NSString *)failedRule fieldClass:(Class)fieldClass;
+@end
+
+
+#pragma mark - EZFormAsyncValidationToken
+
+/* Identifies one round of asynchronous validation. A round is cancelled
+ * as soon as the field needs validating again, and its results are
+ * only accepted while its generation is still the field's current one.
+ */
+@interface EZFormAsyncValidationToken : NSObject
+
+@property (atomic, assign, getter=isCancelled) BOOL cancelled;
+@property (nonatomic, readonly) NSUInteger generation;
+
+- (instancetype)initWithGeneration:(NSUInteger)generation;
+
+@end
+
+@implementation EZFormAsyncValidationToken
+
+- (instancetype)initWithGeneration:(NSUInteger)generation
+{
+    if ((self = [super init])) {
+	_generation = generation;
+    }
+    
+    return self;
+}
+
+@end
+
+
+#pragma mark - External Class Categories
+
+@interface EZFormField (EZFormValidityIndicators)
+- (void)updateValidityIndicators;
+@end
+
+
+#pragma mark - EZFormField class extension
 
 @interface EZFormField () {
     VALIDATOR validatorFn;
     NSMutableArray *validationBlocks;
+    NSMutableArray *asyncValidators;
+    EZFormFieldValidityState validityState;
+    NSUInteger asyncValidationGeneration;
+    EZFormAsyncValidationToken *asyncValidationToken;
+    
+    EZFormValidationFailure validationFailure;	// step failed by the last validation
+    NSUInteger validationFailedValidatorIndex;
+    NSString *validationFailedRule;
+    EZFormFieldValidationReport *cachedValidationReport;	// nil until requested after each validation
+    
+    id cachedModelValue;		// reverse transformed fieldValue
+    NSUInteger cachedModelValueVersion;	// valueVersion of cachedModelValue, 0 if none
+    id lastTransformInput;		// copy of the last model value transformed
+    id lastTransformOutput;
 }
 
 @property (nonatomic, weak, readwrite) EZForm *form;
+@property (nonatomic, assign, readwrite) NSUInteger valueVersion;
 @end
 
 
+#pragma mark - Transformer purity
+
+static BOOL
+EZFormValueTransformerIsPure(NSValueTransformer *valueTransformer)
+{
+    if ([valueTransformer respondsToSelector:@selector(isPure)]) {
+	return [(EZFormValueTransformer *)valueTransformer isPure];
+    }
+    return YES;
+}
+
+/* Whether a model value can be remembered as the input of the last
+ * transformation. Only scalars qualify: their copy holds all of their
+ * content, whereas a copied array or dictionary still shares mutable
+ * elements that can change in place without the copy noticing.
+ */
+static BOOL
+EZFormTransformInputIsCacheable(id modelValue)
+{
+    return ([modelValue isKindOfClass:[NSString class]] ||
+	    [modelValue isKindOfClass:[NSNumber class]] ||
+	    [modelValue isKindOfClass:[NSDate class]] ||
+	    [modelValue isKindOfClass:[NSData class]]);
+}
+
+
 @implementation EZFormField
 
 #pragma mark - Values
@@ -54,19 +152,65 @@
 - (void)setFieldValue:(id)value canUpdateView:(BOOL)canUpdateView
 {
     [(id<EZFormFieldConcrete>)self setActualFieldValue:value];
+    [self fieldValueDidChange];
     
-    if (canUpdateView && [(id<EZFormFieldConcrete>)self respondsToSelector:@selector(updateView)]) {
-	[(id<EZFormFieldConcrete>)self updateView];
+    __strong EZForm *form = self.form;
+    if (canUpdateView && [(id<EZFormFieldConcrete>)self respondsToSelector:@selector(updateView)] && ![form deferViewUpdateForFormField:self]) {
+	[self performUpdateView];
     }
     
-    __strong EZForm *form = self.form;
     [form formFieldDidChangeValue:self];
 }
 
+- (void)performUpdateView
+{
+    __strong EZForm *form = self.form;
+    EZFormInstrumentation *instrumentation = form.instrumentation;
+    uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+    
+    [(id<EZFormFieldConcrete>)self updateView];
+    
+    [instrumentation recordEvent:EZFormInstrumentationEventUpdateView fieldKey:self.key sinceTime:startTime];
+}
+
+- (void)fieldValueDidChange
+{
+    self.valueVersion += 1;
+    [self setNeedsValidation];
+    
+    __strong EZForm *form = self.form;
+    [form formFieldDidChangeModelValue:self];
+}
+
+/* The reverse transformed model value is cached until the field value
+ * changes, so repeated reads between edits (validation, modelValues,
+ * choice view controllers) only transform once. Impure transformers are
+ * called on every read.
+ */
 - (id)modelValue
 {
-    if (self.valueTransformer != nil && [self.valueTransformer.class allowsReverseTransformation]) {
-        return [self.valueTransformer reverseTransformedValue:self.fieldValue];
+    NSValueTransformer *valueTransformer = self.valueTransformer;
+    if (valueTransformer != nil && [valueTransformer.class allowsReverseTransformation]) {
+	__strong EZForm *form = self.form;
+	EZFormInstrumentation *instrumentation = form.instrumentation;
+	BOOL pure = EZFormValueTransformerIsPure(valueTransformer);
+	
+	if (pure && cachedModelValueVersion == self.valueVersion) {
+	    [instrumentation recordEvent:EZFormInstrumentationEventReverseTransformedValueCacheHit fieldKey:self.key duration:0.0];
+	    return cachedModelValue;
+	}
+	
+	uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+	
+        id modelValue = [valueTransformer reverseTransformedValue:self.fieldValue];
+	
+	[instrumentation recordEvent:EZFormInstrumentationEventReverseTransformedValue fieldKey:self.key sinceTime:startTime];
+	
+	if (pure) {
+	    cachedModelValue = modelValue;
+	    cachedModelValueVersion = self.valueVersion;
+	}
+	return modelValue;
     }
     return self.fieldValue;
 }
@@ -76,13 +220,67 @@
     [self setModelValue:modelValue canUpdateView:YES];
 }
 
+- (void)setValueTransformer:(NSValueTransformer *)valueTransformer
+{
+    _valueTransformer = valueTransformer;
+    [self invalidateTransformedValues];
+    [self setNeedsValidation];
+    
+    __strong EZForm *form = self.form;
+    [form formFieldDidChangeModelValue:self];
+}
+
 - (void)setModelValue:(id)modelValue canUpdateView:(BOOL)canUpdateView {
-    if (self.valueTransformer != nil) {
-        modelValue = [self.valueTransformer transformedValue:modelValue];
-    }
+    modelValue = [self transformedValueForModelValue:modelValue];
     [self setFieldValue:modelValue canUpdateView:canUpdateView];
 }
 
+/* Setting the same string, number, date or data model value again (e.g.
+ * from setModelValues:) reuses the previous result of a pure transformer.
+ * The input is copied, so a mutable string or data changed in place is
+ * not mistaken for a hit.
+ */
+- (id)transformedValueForModelValue:(id)modelValue
+{
+    NSValueTransformer *valueTransformer = self.valueTransformer;
+    if (valueTransformer == nil) {
+	return modelValue;
+    }
+    
+    __strong EZForm *form = self.form;
+    EZFormInstrumentation *instrumentation = form.instrumentation;
+    BOOL cacheable = (EZFormValueTransformerIsPure(valueTransformer) && EZFormTransformInputIsCacheable(modelValue));
+    
+    if (cacheable && lastTransformInput != nil && [lastTransformInput isEqual:modelValue]) {
+	[instrumentation recordEvent:EZFormInstrumentationEventTransformedValueCacheHit fieldKey:self.key duration:0.0];
+	return lastTransformOutput;
+    }
+    
+    uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+    
+    id transformedValue = [valueTransformer transformedValue:modelValue];
+    
+    [instrumentation recordEvent:EZFormInstrumentationEventTransformedValue fieldKey:self.key sinceTime:startTime];
+    
+    if (cacheable) {
+	lastTransformInput = [modelValue copy];
+	lastTransformOutput = transformedValue;
+    }
+    else {
+	lastTransformInput = nil;
+	lastTransformOutput = nil;
+    }
+    return transformedValue;
+}
+
+- (void)invalidateTransformedValues
+{
+    cachedModelValue = nil;
+    cachedModelValueVersion = 0;
+    lastTransformInput = nil;
+    lastTransformOutput = nil;
+}
+
 #pragma mark - UIResponder
 
 - (void)becomeFirstResponder
@@ -130,6 +328,7 @@
 - (void)setValidationFunction:(VALIDATOR)validatorFunction
 {
     validatorFn = validatorFunction;
+    [self setNeedsValidation];
 }
 
 - (void)setValidator:(BOOL (^)(id value))validator
@@ -138,31 +337,218 @@
     if (validator) {
         [self addValidator:validator];
     }
+    [self setNeedsValidation];
 }
 
 - (void)addValidator:(BOOL (^)(id value))validator
 {
     [validationBlocks addObject:[validator copy]];
+    [self setNeedsValidation];
+}
+
+- (void)setValidationDisabled:(BOOL)validationDisabled
+{
+    _validationDisabled = validationDisabled;
+    [self setNeedsValidation];
+}
+
+- (void)setValidationRules:(EZFormValidationRules *)validationRules
+{
+    _validationRules = validationRules;
+    [self setNeedsValidation];
+}
+
+- (void)setKey:(NSString *)key
+{
+    if (key == _key || [key isEqualToString:_key]) {
+	return;
+    }
+    
+    __strong EZForm *form = self.form;
+    [form formField:self willChangeKey:key];
+    
+    _key = [key copy];
+    [form formFieldDidChangeKey:self];
+}
+
+- (void)setValidationDependencyKeys:(NSArray *)validationDependencyKeys
+{
+    __strong EZForm *form = self.form;
+    [form formField:self willChangeValidationDependencyKeys:validationDependencyKeys];
+    
+    _validationDependencyKeys = [validationDependencyKeys copy];
+    [self setNeedsValidation];
+}
+
+- (void)addAsyncValidator:(EZFormAsyncValidator *)asyncValidator
+{
+    [asyncValidators addObject:asyncValidator];
+    [self setNeedsValidation];
+}
+
+- (void)removeAsyncValidators
+{
+    [asyncValidators removeAllObjects];
+    [self setNeedsValidation];
+}
+
+- (void)setNeedsValidation
+{
+    validityState = EZFormFieldValidityStateUnknown;
+    cachedValidationReport = nil;
+    
+    // Any asynchronous validation in flight is for a stale value
+    asyncValidationToken.cancelled = YES;
+    asyncValidationToken = nil;
+    
+    __strong EZForm *form = self.form;
+    [form formFieldNeedsValidation:self];
 }
 
 - (BOOL)isValid
+{
+    if (EZFormFieldValidityStateUnknown == validityState) {
+	__strong EZForm *form = self.form;
+	EZFormInstrumentation *instrumentation = form.instrumentation;
+	uint64_t startTime = (instrumentation ? mach_absolute_time() : 0);
+	BOOL result = [self evaluateValidityWithInstrumentation:instrumentation];
+	[instrumentation recordEvent:EZFormInstrumentationEventIsValid fieldKey:self.key sinceTime:startTime];
+	BOOL needsAsyncValidation = (result && !_validationDisabled && [asyncValidators count] > 0);
+	if (needsAsyncValidation) {
+	    validityState = EZFormFieldValidityStatePending;
+	    result = NO;
+	}
+	else {
+	    validityState = (result ? EZFormFieldValidityStateValid : EZFormFieldValidityStateInvalid);
+	}
+	
+	[form formField:self didResolveValidity:result];
+	
+	if (needsAsyncValidation) {
+	    [self beginAsyncValidation];
+	}
+    }
+    
+    return (EZFormFieldValidityStateValid == validityState);
+}
+
+- (EZFormFieldValidationReport *)validationReport
+{
+    [self isValid];
+    
+    if (nil == cachedValidationReport) {
+	EZFormValidationFailure failure = (EZFormFieldValidityStatePending == validityState ? EZFormValidationFailurePending : validationFailure);
+	cachedValidationReport = [[EZFormFieldValidationReport alloc] initWithKey:self.key valueVersion:self.valueVersion failure:failure failedValidatorIndex:validationFailedValidatorIndex failedRule:validationFailedRule fieldClass:[self class]];
+    }
+    return cachedValidationReport;
+}
+
+- (void)recordValidationFailure:(EZFormValidationFailure)failure validatorIndex:(NSUInteger)validatorIndex rule:(NSString *)rule
+{
+    validationFailure = failure;
+    validationFailedValidatorIndex = validatorIndex;
+    validationFailedRule = rule;
+}
+
+- (BOOL)isValidationPending
+{
+    return (EZFormFieldValidityStatePending == validityState);
+}
+
+- (void)beginAsyncValidation
+{
+    EZFormAsyncValidationToken *token = [[EZFormAsyncValidationToken alloc] initWithGeneration:++asyncValidationGeneration];
+    asyncValidationToken = token;
+    
+    id value = self.modelValue;
+    NSArray *validators = [asyncValidators copy];
+    __block NSUInteger remainingValidators = [validators count]; // only accessed on the main queue
+    __weak EZFormField *weakSelf = self;
+    
+    BOOL (^isCancelled)(void) = ^BOOL{
+	return token.isCancelled;
+    };
+    
+    for (EZFormAsyncValidator *validator in validators) {
+	[validator validateValue:value isCancelled:isCancelled completion:^(BOOL valid) {
+	    EZFormField *strongSelf = weakSelf;
+	    if (nil == strongSelf || token.isCancelled || token.generation != strongSelf->asyncValidationGeneration) {
+		// Result for a value that has since changed
+		return;
+	    }
+	    
+	    remainingValidators--;
+	    if (!valid || remainingValidators == 0) {
+		token.cancelled = YES; // ignore any remaining results of this round
+		[strongSelf finishAsyncValidationWithResult:valid];
+	    }
+	}];
+    }
+    
+    __strong EZForm *form = self.form;
+    [form formFieldDidBeginPendingValidation:self];
+}
+
+- (void)finishAsyncValidationWithResult:(BOOL)valid
+{
+    asyncValidationToken = nil;
+    validityState = (valid ? EZFormFieldValidityStateValid : EZFormFieldValidityStateInvalid);
+    validationFailure = (valid ? EZFormValidationFailureNone : EZFormValidationFailureAsyncValidator);
+    cachedValidationReport = nil;
+    
+    __strong EZForm *form = self.form;
+    [form formField:self didResolveValidity:valid];
+    
+    if ([self respondsToSelector:@selector(updateValidityIndicators)]) {
+	[self updateValidityIndicators];
+    }
+    
+    [form formFieldDidResolvePendingValidation:self];
+}
+
+/* Runs every validation step, stopping at the first failure. With
+ * instrumentation, the duration of each step is recorded; without it,
+ * no time is read.
+ */
+- (BOOL)evaluateValidityWithInstrumentation:(EZFormInstrumentation *)instrumentation
 {
     BOOL result = YES;
+    validationFailure = EZFormValidationFailureNone;
     
     if (!_validationDisabled) {
 	id value = self.modelValue;
+	uint64_t startTime;
 	
-	for (unsigned i=0; result && i < [validationBlocks count]; i++) {
+	for (NSUInteger i=0; result && i < [validationBlocks count]; i++) {
 	    BOOL (^validator)(id value) = validationBlocks[i];
+	    startTime = (instrumentation ? mach_absolute_time() : 0);
 	    result = validator(value);
+	    if (instrumentation) {
+		[instrumentation recordEvent:EZFormInstrumentationEventValidator(i) fieldKey:self.key sinceTime:startTime];
+	    }
+	    if (!result) [self recordValidationFailure:EZFormValidationFailureValidator validatorIndex:i rule:nil];
 	}
 	
 	if (result && validatorFn) {
+	    startTime = (instrumentation ? mach_absolute_time() : 0);
 	    result = validatorFn(value);
+	    [instrumentation recordEvent:EZFormInstrumentationEventValidationFunction fieldKey:self.key sinceTime:startTime];
+	    if (!result) [self recordValidationFailure:EZFormValidationFailureValidationFunction validatorIndex:NSNotFound rule:nil];
+	}
+	
+	if (result && _validationRules) {
+	    NSString *failedRule = nil;
+	    startTime = (instrumentation ? mach_absolute_time() : 0);
+	    result = [_validationRules validateValue:value failedRule:&failedRule];
+	    [instrumentation recordEvent:EZFormInstrumentationEventValidationRules fieldKey:self.key sinceTime:startTime];
+	    if (!result) [self recordValidationFailure:EZFormValidationFailureValidationRules validatorIndex:NSNotFound rule:failedRule];
 	}
 	
 	if (result && [self respondsToSelector:@selector(typeSpecificValidation)]) {
+	    startTime = (instrumentation ? mach_absolute_time() : 0);
 	    result = [(id<EZFormFieldConcrete>)self typeSpecificValidation];
+	    [instrumentation recordEvent:EZFormInstrumentationEventTypeSpecificValidation fieldKey:self.key sinceTime:startTime];
+	    if (!result) [self recordValidationFailure:EZFormValidationFailureTypeSpecific validatorIndex:NSNotFound rule:nil];
 	}
     }
     
@@ -202,8 +588,10 @@
 {
     if ((self = [super init])) {
 	self.key = aKey;
+	self.valueVersion = 1;
 	
 	validationBlocks = [[NSMutableArray alloc] init];
+	asyncValidators = [[NSMutableArray alloc] init];
     }
     
     return self;
@@ -84,6 +84,15 @@ typedef NS_ENUM(NSInteger, EZFormGenericFieldUserControlType) {
 }
 
 
+#pragma mark - Validation rules
+
+- (void)setValidationNotNil:(BOOL)validationNotNil
+{
+    _validationNotNil = validationNotNil;
+    [self setNeedsValidation];
+}
+
+
 #pragma mark - EZFormFieldConcrete methods
 
 - (BOOL)typeSpecificValidation
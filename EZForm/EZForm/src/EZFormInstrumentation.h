@@ -0,0 +1,161 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** Event names recorded for form fields.
+ *
+ *  Each validator block added to a field is recorded separately, as
+ *  "validator[0]", "validator[1]" and so on, in the order they were
+ *  added.
+ *
+ *  The cache hit events count transformer calls saved by the field's
+ *  transformer result cache and are recorded with zero duration. The
+ *  reverse transformation hit rate of a field is the count of
+ *  EZFormInstrumentationEventReverseTransformedValueCacheHit divided by
+ *  its sum with the count of EZFormInstrumentationEventReverseTransformedValue.
+ */
+extern NSString * const EZFormInstrumentationEventIsValid;
+extern NSString * const EZFormInstrumentationEventValidationFunction;
+extern NSString * const EZFormInstrumentationEventValidationRules;
+extern NSString * const EZFormInstrumentationEventTypeSpecificValidation;
+extern NSString * const EZFormInstrumentationEventTransformedValue;
+extern NSString * const EZFormInstrumentationEventReverseTransformedValue;
+extern NSString * const EZFormInstrumentationEventTransformedValueCacheHit;
+extern NSString * const EZFormInstrumentationEventReverseTransformedValueCacheHit;
+extern NSString * const EZFormInstrumentationEventUpdateView;
+
+/** Number of buckets in an EZFormTimingStatistics histogram.
+ */
+#define EZFormTimingHistogramBucketCount 32
+
+
+/** Call count and latency statistics of one instrumented event.
+ */
+@interface EZFormTimingStatistics : NSObject <NSCopying>
+
+/** Number of recorded calls.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/** Total, shortest, longest and mean duration of the recorded calls,
+ *  in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+@property (nonatomic, readonly) NSTimeInterval minimumDuration;
+@property (nonatomic, readonly) NSTimeInterval maximumDuration;
+@property (nonatomic, readonly) NSTimeInterval meanDuration;
+
+/** Latency histogram as an array of EZFormTimingHistogramBucketCount
+ *  call counts.
+ *
+ *  Bucket 0 counts calls faster than 1 microsecond. Bucket i counts
+ *  calls taking from 2^(i-1) up to 2^i microseconds. The last bucket
+ *  also counts every slower call.
+ */
+@property (nonatomic, readonly, copy) NSArray *histogram;
+
+/** A dictionary of the statistics, suitable for JSON serialization.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *dictionaryRepresentation;
+
+@end
+
+
+/** Records call counts and latencies of form field validation, value
+ *  transformation, view updates and form delegate callbacks.
+ *
+ *  Instrumentation is off by default. Assign an EZFormInstrumentation
+ *  object to the instrumentation property of an EZForm to turn it on
+ *  for that form; set it back to nil to turn it off. While it is off the
+ *  form and its fields skip all timing.
+ *
+ *  Field events are recorded per field key, using the event names
+ *  declared above. Form delegate callbacks are recorded as form events
+ *  named after the delegate method selector.
+ *
+ *  EZFormInstrumentation is not thread safe and should only be used on
+ *  the main thread, like the form itself.
+ */
+@interface EZFormInstrumentation : NSObject
+
+/** Keys of all fields with recorded events.
+ */
+@property (nonatomic, readonly, copy) NSArray *fieldKeys;
+
+/** Names of all events recorded for a field.
+ *
+ *  @param fieldKey A field key.
+ *
+ *  @returns An array of event names.
+ */
+- (NSArray *)eventsForFieldKey:(NSString *)fieldKey;
+
+/** Names of all recorded form events.
+ */
+@property (nonatomic, readonly, copy) NSArray *formEvents;
+
+/** Returns the statistics of a recorded event.
+ *
+ *  @param event The event name.
+ *
+ *  @param fieldKey The field key, or nil for a form event.
+ *
+ *  @returns A snapshot of the statistics, or nil if the event was never
+ *  recorded.
+ */
+- (EZFormTimingStatistics *)statisticsForEvent:(NSString *)event fieldKey:(NSString *)fieldKey;
+
+/** Records one call of an event.
+ *
+ *  Can be used to record application-defined events alongside the
+ *  built-in ones.
+ *
+ *  @param event The event name.
+ *
+ *  @param fieldKey The field key, or nil for a form event.
+ *
+ *  @param duration The duration of the call, in seconds.
+ */
+- (void)recordEvent:(NSString *)event fieldKey:(NSString *)fieldKey duration:(NSTimeInterval)duration;
+
+/** Discards all recorded statistics.
+ */
+- (void)reset;
+
+/** All recorded statistics as a dictionary with "fields" and "form"
+ *  entries, suitable for JSON serialization.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *dictionaryRepresentation;
+
+/** Returns all recorded statistics as JSON data.
+ *
+ *  @param error On return, an error if serialization failed.
+ *
+ *  @returns JSON data, or nil on error.
+ */
+- (NSData *)JSONDataWithError:(NSError **)error;
+
+@end
@@ -0,0 +1,269 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormInstrumentation.h"
+#import "EZFormInstrumentation+Private.h"
+
+NSString * const EZFormInstrumentationEventIsValid = @"isValid";
+NSString * const EZFormInstrumentationEventValidationFunction = @"validationFunction";
+NSString * const EZFormInstrumentationEventValidationRules = @"validationRules";
+NSString * const EZFormInstrumentationEventTypeSpecificValidation = @"typeSpecificValidation";
+NSString * const EZFormInstrumentationEventTransformedValue = @"transformedValue";
+NSString * const EZFormInstrumentationEventReverseTransformedValue = @"reverseTransformedValue";
+NSString * const EZFormInstrumentationEventTransformedValueCacheHit = @"transformedValueCacheHit";
+NSString * const EZFormInstrumentationEventReverseTransformedValueCacheHit = @"reverseTransformedValueCacheHit";
+NSString * const EZFormInstrumentationEventUpdateView = @"updateView";
+
+
+NSString *
+EZFormInstrumentationEventValidator(NSUInteger index)
+{
+    // Main thread only, like the rest of instrumentation
+    static NSMutableArray *eventNames = nil;
+    if (nil == eventNames) {
+	eventNames = [[NSMutableArray alloc] init];
+    }
+    
+    while ([eventNames count] <= index) {
+	[eventNames addObject:[NSString stringWithFormat:@"validator[%lu]", (unsigned long)[eventNames count]]];
+    }
+    return eventNames[index];
+}
+
+
+static NSTimeInterval
+EZFormInstrumentationSecondsFromMachTime(uint64_t machTime)
+{
+    static mach_timebase_info_data_t timebase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	mach_timebase_info(&timebase);
+    });
+    
+    return (NSTimeInterval)machTime * timebase.numer / timebase.denom / NSEC_PER_SEC;
+}
+
+
+#pragma mark - EZFormTimingStatistics
+
+@interface EZFormTimingStatistics () {
+    NSUInteger histogramCounts[EZFormTimingHistogramBucketCount];
+}
+
+@property (nonatomic, readwrite) NSUInteger count;
+@property (nonatomic, readwrite) NSTimeInterval totalDuration;
+@property (nonatomic, readwrite) NSTimeInterval minimumDuration;
+@property (nonatomic, readwrite) NSTimeInterval maximumDuration;
+
+- (void)addDuration:(NSTimeInterval)duration;
+
+@end
+
+@implementation EZFormTimingStatistics
+
+- (void)addDuration:(NSTimeInterval)duration
+{
+    if (self.count == 0 || duration < self.minimumDuration) {
+	self.minimumDuration = duration;
+    }
+    if (duration > self.maximumDuration) {
+	self.maximumDuration = duration;
+    }
+    self.count++;
+    self.totalDuration += duration;
+    
+    NSUInteger bucket = 0;
+    double microseconds = duration * 1000000.0;
+    while (microseconds >= 1.0 && bucket < EZFormTimingHistogramBucketCount - 1) {
+	microseconds /= 2.0;
+	bucket++;
+    }
+    histogramCounts[bucket]++;
+}
+
+- (NSTimeInterval)meanDuration
+{
+    return (self.count > 0 ? self.totalDuration / self.count : 0.0);
+}
+
+- (NSArray *)histogram
+{
+    NSMutableArray *histogram = [NSMutableArray arrayWithCapacity:EZFormTimingHistogramBucketCount];
+    for (NSUInteger i=0; i < EZFormTimingHistogramBucketCount; i++) {
+	[histogram addObject:@(histogramCounts[i])];
+    }
+    return histogram;
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    return @{
+	@"count": @(self.count),
+	@"totalDuration": @(self.totalDuration),
+	@"minimumDuration": @(self.minimumDuration),
+	@"maximumDuration": @(self.maximumDuration),
+	@"meanDuration": @(self.meanDuration),
+	@"histogram": self.histogram,
+    };
+}
+
+
+#pragma mark NSCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    EZFormTimingStatistics *copy = [[[self class] allocWithZone:zone] init];
+    copy.count = self.count;
+    copy.totalDuration = self.totalDuration;
+    copy.minimumDuration = self.minimumDuration;
+    copy.maximumDuration = self.maximumDuration;
+    memcpy(copy->histogramCounts, histogramCounts, sizeof(histogramCounts));
+    return copy;
+}
+
+
+#pragma mark NSObject methods
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p count=%lu mean=%gs max=%gs>", [self class], self, (unsigned long)self.count, self.meanDuration, self.maximumDuration];
+}
+
+@end
+
+
+#pragma mark - EZFormInstrumentation class extension
+
+@interface EZFormInstrumentation ()
+@property (nonatomic, strong) NSMutableDictionary *fieldStatistics;	// field key -> event -> EZFormTimingStatistics
+@property (nonatomic, strong) NSMutableDictionary *formStatistics;	// event -> EZFormTimingStatistics
+@end
+
+
+#pragma mark - EZFormInstrumentation implementation
+
+@implementation EZFormInstrumentation
+
+
+#pragma mark - Recording
+
+- (void)recordEvent:(NSString *)event fieldKey:(NSString *)fieldKey duration:(NSTimeInterval)duration
+{
+    NSMutableDictionary *eventStatistics = self.formStatistics;
+    if (fieldKey) {
+	eventStatistics = self.fieldStatistics[fieldKey];
+	if (nil == eventStatistics) {
+	    eventStatistics = [NSMutableDictionary dictionary];
+	    self.fieldStatistics[fieldKey] = eventStatistics;
+	}
+    }
+    
+    EZFormTimingStatistics *statistics = eventStatistics[event];
+    if (nil == statistics) {
+	statistics = [[EZFormTimingStatistics alloc] init];
+	eventStatistics[event] = statistics;
+    }
+    [statistics addDuration:duration];
+}
+
+- (void)recordEvent:(NSString *)event fieldKey:(NSString *)fieldKey sinceTime:(uint64_t)startTime
+{
+    NSTimeInterval duration = EZFormInstrumentationSecondsFromMachTime(mach_absolute_time() - startTime);
+    [self recordEvent:event fieldKey:fieldKey duration:duration];
+}
+
+- (void)reset
+{
+    [self.fieldStatistics removeAllObjects];
+    [self.formStatistics removeAllObjects];
+}
+
+
+#pragma mark - Queries
+
+- (NSArray *)fieldKeys
+{
+    return [self.fieldStatistics allKeys];
+}
+
+- (NSArray *)eventsForFieldKey:(NSString *)fieldKey
+{
+    return [self.fieldStatistics[fieldKey] allKeys];
+}
+
+- (NSArray *)formEvents
+{
+    return [self.formStatistics allKeys];
+}
+
+- (EZFormTimingStatistics *)statisticsForEvent:(NSString *)event fieldKey:(NSString *)fieldKey
+{
+    NSDictionary *eventStatistics = (fieldKey ? self.fieldStatistics[fieldKey] : self.formStatistics);
+    return [eventStatistics[event] copy];
+}
+
+
+#pragma mark - Serialization
+
++ (NSDictionary *)dictionaryRepresentationOfEventStatistics:(NSDictionary *)eventStatistics
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:[eventStatistics count]];
+    [eventStatistics enumerateKeysAndObjectsUsingBlock:^(NSString *event, EZFormTimingStatistics *statistics, __unused BOOL *stop) {
+	dictionary[event] = statistics.dictionaryRepresentation;
+    }];
+    return dictionary;
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *fields = [NSMutableDictionary dictionaryWithCapacity:[self.fieldStatistics count]];
+    [self.fieldStatistics enumerateKeysAndObjectsUsingBlock:^(NSString *fieldKey, NSDictionary *eventStatistics, __unused BOOL *stop) {
+	fields[fieldKey] = [[self class] dictionaryRepresentationOfEventStatistics:eventStatistics];
+    }];
+    
+    return @{
+	@"fields": fields,
+	@"form": [[self class] dictionaryRepresentationOfEventStatistics:self.formStatistics],
+    };
+}
+
+- (NSData *)JSONDataWithError:(NSError **)error
+{
+    return [NSJSONSerialization dataWithJSONObject:self.dictionaryRepresentation options:NSJSONWritingPrettyPrinted error:error];
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)init
+{
+    if ((self = [super init])) {
+	_fieldStatistics = [[NSMutableDictionary alloc] init];
+	_formStatistics = [[NSMutableDictionary alloc] init];
+    }
+    
+    return self;
+}
+
+@end
@@ -0,0 +1,79 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** Reads the value at a key path of objects, like valueForKeyPath:,
+ *  without parsing the key path or searching for accessors on every
+ *  call.
+ *
+ *  The key path is split into keys once. The getter method, or the
+ *  instance variable, for each key is looked up the first time an object
+ *  of a class is seen and reused for every following object of the same
+ *  class, so mapping an array of model objects of one class costs a
+ *  direct method call per key. Each key remembers the lookups of the
+ *  first four classes it sees; objects of any further class are read
+ *  with valueForKey:.
+ *
+ *  Key value coding is used instead for keys with no getter or instance
+ *  variable, for collection and dictionary objects, for scalar getters
+ *  of struct type and for key paths containing collection operators such
+ *  as "@count". Scalar getter results are boxed in NSNumbers like
+ *  valueForKey: does.
+ *
+ *  Lookups are cached in the accessor, so an accessor should only be
+ *  used from one thread at a time.
+ */
+@interface EZFormKeyPathAccessor : NSObject
+
+/** Creates an accessor for a key path.
+ *
+ *  @param keyPath A key path of dot-separated keys.
+ *
+ *  @returns An EZFormKeyPathAccessor object.
+ */
++ (instancetype)accessorWithKeyPath:(NSString *)keyPath;
+
+/** Initialises an accessor for a key path.
+ *
+ *  @param keyPath A key path of dot-separated keys.
+ *
+ *  @returns Initialised EZFormKeyPathAccessor object.
+ */
+- (instancetype)initWithKeyPath:(NSString *)keyPath NS_DESIGNATED_INITIALIZER;
+
+/** The key path.
+ */
+@property (nonatomic, readonly, copy) NSString *keyPath;
+
+/** Returns the value at the key path of an object.
+ *
+ *  @param object The object to read from.
+ *
+ *  @returns The value, or nil if object or any intermediate value is nil.
+ */
+- (id)valueForObject:(id)object;
+
+@end
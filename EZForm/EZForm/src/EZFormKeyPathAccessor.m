@@ -0,0 +1,282 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <objc/runtime.h>
+#import "EZFormKeyPathAccessor.h"
+
+
+typedef NS_ENUM(NSInteger, EZFormKeyAccessKind) {
+    EZFormKeyAccessKindKeyValueCoding = 0,	// valueForKey:
+    EZFormKeyAccessKindObject,			// getter returning an object
+    EZFormKeyAccessKindIvar,			// object instance variable
+    EZFormKeyAccessKindChar,
+    EZFormKeyAccessKindUnsignedChar,
+    EZFormKeyAccessKindShort,
+    EZFormKeyAccessKindUnsignedShort,
+    EZFormKeyAccessKindInt,
+    EZFormKeyAccessKindUnsignedInt,
+    EZFormKeyAccessKindLong,
+    EZFormKeyAccessKindUnsignedLong,
+    EZFormKeyAccessKindLongLong,
+    EZFormKeyAccessKindUnsignedLongLong,
+    EZFormKeyAccessKindFloat,
+    EZFormKeyAccessKindDouble,
+    EZFormKeyAccessKindBool,
+} ;
+
+/* Number of classes a key remembers how to read. Objects of any further
+ * class are read with valueForKey: rather than resolved again.
+ */
+#define EZFormKeyAccessCacheSize 4
+
+/* How to read a key from objects of one class. Classes are never
+ * deallocated.
+ */
+typedef struct {
+    __unsafe_unretained Class cachedClass;	// Nil while unused
+    SEL selector;
+    IMP imp;
+    Ivar ivar;
+    EZFormKeyAccessKind kind;
+} EZFormKeyAccessEntry;
+
+/* How to read one key of the key path, for the first few classes seen.
+ * Keys are retained by the accessor's keys array.
+ */
+typedef struct {
+    __unsafe_unretained NSString *key;
+    EZFormKeyAccessEntry entries[EZFormKeyAccessCacheSize];
+    NSUInteger entryCount;
+} EZFormKeyAccess;
+
+
+static EZFormKeyAccessKind
+EZFormKeyAccessKindForReturnType(const char *type)
+{
+    // Skip method type qualifiers (const, in, out, oneway, etc)
+    while (*type != '\0' && strchr("rnNoORV", *type) != NULL) {
+	type++;
+    }
+    
+    switch (*type) {
+	case '@':
+	case '#': return EZFormKeyAccessKindObject;
+	case 'c': return EZFormKeyAccessKindChar;
+	case 'C': return EZFormKeyAccessKindUnsignedChar;
+	case 's': return EZFormKeyAccessKindShort;
+	case 'S': return EZFormKeyAccessKindUnsignedShort;
+	case 'i': return EZFormKeyAccessKindInt;
+	case 'I': return EZFormKeyAccessKindUnsignedInt;
+	case 'l': return EZFormKeyAccessKindLong;
+	case 'L': return EZFormKeyAccessKindUnsignedLong;
+	case 'q': return EZFormKeyAccessKindLongLong;
+	case 'Q': return EZFormKeyAccessKindUnsignedLongLong;
+	case 'f': return EZFormKeyAccessKindFloat;
+	case 'd': return EZFormKeyAccessKindDouble;
+	case 'B': return EZFormKeyAccessKindBool;
+	default:  return EZFormKeyAccessKindKeyValueCoding;	// structs, pointers, void
+    }
+}
+
+/* Looks up the getter, or object instance variable, that valueForKey:
+ * would use for a key, in the same search order.
+ */
+static void
+EZFormKeyAccessResolve(EZFormKeyAccessEntry *access, NSString *key, Class cls)
+{
+    static IMP defaultValueForKeyIMP = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	defaultValueForKeyIMP = [NSObject instanceMethodForSelector:@selector(valueForKey:)];
+    });
+    
+    access->cachedClass = cls;
+    access->kind = EZFormKeyAccessKindKeyValueCoding;
+    access->selector = NULL;
+    access->imp = NULL;
+    access->ivar = NULL;
+    
+    // Collections, dictionaries, managed objects etc have their own valueForKey:
+    if (class_getMethodImplementation(cls, @selector(valueForKey:)) != defaultValueForKeyIMP) {
+	return;
+    }
+    
+    if ([key length] == 0) {
+	return;
+    }
+    NSString *capitalizedKey = [[[key substringToIndex:1] uppercaseString] stringByAppendingString:[key substringFromIndex:1]];
+    
+    NSArray *getterNames = @[[@"get" stringByAppendingString:capitalizedKey], key, [@"is" stringByAppendingString:capitalizedKey], [@"_" stringByAppendingString:key]];
+    for (NSString *getterName in getterNames) {
+	SEL selector = NSSelectorFromString(getterName);
+	Method method = class_getInstanceMethod(cls, selector);
+	if (method != NULL && method_getNumberOfArguments(method) == 2) {
+	    char returnType[16];
+	    method_getReturnType(method, returnType, sizeof(returnType));
+	    access->kind = EZFormKeyAccessKindForReturnType(returnType);
+	    if (access->kind != EZFormKeyAccessKindKeyValueCoding) {
+		access->selector = selector;
+		access->imp = method_getImplementation(method);
+	    }
+	    return;
+	}
+    }
+    
+    if ([cls accessInstanceVariablesDirectly]) {
+	NSArray *ivarNames = @[[@"_" stringByAppendingString:key], [@"_is" stringByAppendingString:capitalizedKey], key, [@"is" stringByAppendingString:capitalizedKey]];
+	for (NSString *ivarName in ivarNames) {
+	    Ivar ivar = class_getInstanceVariable(cls, [ivarName UTF8String]);
+	    if (ivar != NULL) {
+		const char *ivarType = ivar_getTypeEncoding(ivar);
+		if (ivarType != NULL && ivarType[0] == '@') {
+		    access->kind = EZFormKeyAccessKindIvar;
+		    access->ivar = ivar;
+		}
+		return;
+	    }
+	}
+    }
+}
+
+/* Returns the cache entry for cls, resolving it into a free entry on
+ * first use. Returns NULL once the cache is full of other classes.
+ */
+static EZFormKeyAccessEntry *
+EZFormKeyAccessEntryForClass(EZFormKeyAccess *access, Class cls)
+{
+    for (NSUInteger i=0; i < access->entryCount; i++) {
+	if (access->entries[i].cachedClass == cls) {
+	    return &access->entries[i];
+	}
+    }
+    
+    if (access->entryCount == EZFormKeyAccessCacheSize) {
+	return NULL;
+    }
+    
+    EZFormKeyAccessEntry *entry = &access->entries[access->entryCount++];
+    EZFormKeyAccessResolve(entry, access->key, cls);
+    return entry;
+}
+
+#define EZFormKeyAccessCallGetter(type, access, object) (((type (*)(id, SEL))(access)->imp)((object), (access)->selector))
+
+static id
+EZFormKeyAccessValue(EZFormKeyAccess *keyAccess, id object)
+{
+    EZFormKeyAccessEntry *access = EZFormKeyAccessEntryForClass(keyAccess, object_getClass(object));
+    if (NULL == access) {
+	return [object valueForKey:keyAccess->key];
+    }
+    
+    switch (access->kind) {
+	case EZFormKeyAccessKindKeyValueCoding:	return [object valueForKey:keyAccess->key];
+	case EZFormKeyAccessKindObject:		return EZFormKeyAccessCallGetter(id, access, object);
+	case EZFormKeyAccessKindIvar:		return object_getIvar(object, access->ivar);
+	case EZFormKeyAccessKindChar:		return @(EZFormKeyAccessCallGetter(char, access, object));
+	case EZFormKeyAccessKindUnsignedChar:	return @(EZFormKeyAccessCallGetter(unsigned char, access, object));
+	case EZFormKeyAccessKindShort:		return @(EZFormKeyAccessCallGetter(short, access, object));
+	case EZFormKeyAccessKindUnsignedShort:	return @(EZFormKeyAccessCallGetter(unsigned short, access, object));
+	case EZFormKeyAccessKindInt:		return @(EZFormKeyAccessCallGetter(int, access, object));
+	case EZFormKeyAccessKindUnsignedInt:	return @(EZFormKeyAccessCallGetter(unsigned int, access, object));
+	case EZFormKeyAccessKindLong:		return @(EZFormKeyAccessCallGetter(long, access, object));
+	case EZFormKeyAccessKindUnsignedLong:	return @(EZFormKeyAccessCallGetter(unsigned long, access, object));
+	case EZFormKeyAccessKindLongLong:	return @(EZFormKeyAccessCallGetter(long long, access, object));
+	case EZFormKeyAccessKindUnsignedLongLong: return @(EZFormKeyAccessCallGetter(unsigned long long, access, object));
+	case EZFormKeyAccessKindFloat:		return @(EZFormKeyAccessCallGetter(float, access, object));
+	case EZFormKeyAccessKindDouble:		return @(EZFormKeyAccessCallGetter(double, access, object));
+	case EZFormKeyAccessKindBool:		return @(EZFormKeyAccessCallGetter(bool, access, object));
+    }
+    
+    return [object valueForKey:keyAccess->key];
+}
+
+
+#pragma mark - EZFormKeyPathAccessor class extension
+
+@interface EZFormKeyPathAccessor () {
+    EZFormKeyAccess *_accesses;	// one for each key
+    NSUInteger _accessCount;
+}
+
+@property (nonatomic, readwrite, copy) NSString *keyPath;
+@property (nonatomic, copy) NSArray *keys;			// owns the keys referenced by _accesses
+@property (nonatomic, assign) BOOL usesKeyValueCoding;	// key path has collection operators
+
+@end
+
+
+#pragma mark - EZFormKeyPathAccessor implementation
+
+@implementation EZFormKeyPathAccessor
+
++ (instancetype)accessorWithKeyPath:(NSString *)keyPath
+{
+    return [[self alloc] initWithKeyPath:keyPath];
+}
+
+- (id)valueForObject:(id)object
+{
+    if (self.usesKeyValueCoding) {
+	return [object valueForKeyPath:self.keyPath];
+    }
+    
+    id value = object;
+    for (NSUInteger i=0; i < _accessCount && value != nil; i++) {
+	value = EZFormKeyAccessValue(&_accesses[i], value);
+    }
+    return value;
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithKeyPath:(NSString *)keyPath
+{
+    if ((self = [super init])) {
+	self.keyPath = keyPath;
+	self.keys = [keyPath componentsSeparatedByString:@"."];
+	self.usesKeyValueCoding = ([keyPath rangeOfString:@"@"].location != NSNotFound);
+	
+	_accessCount = [self.keys count];
+	_accesses = calloc(_accessCount, sizeof(EZFormKeyAccess));
+	for (NSUInteger i=0; i < _accessCount; i++) {
+	    _accesses[i].key = self.keys[i];
+	}
+    }
+    
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithKeyPath:@""];
+}
+
+- (void)dealloc
+{
+    free(_accesses);
+}
+
+@end
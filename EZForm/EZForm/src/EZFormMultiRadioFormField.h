@@ -44,10 +44,22 @@
 
 /** Currently selected keys. 
  *
- *  Returns an NSArray of selected keys and nil if no keys are selected.
+ *  Returns an NSArray of selected keys, in the order they were selected.
+ *  Setting a key adds it to the selection; setting nil clears it.
  */
 @property (nonatomic, strong) id fieldValue;
 
+/** Selects several choices at once.
+ *
+ *  Adds every key in values to the selection, then validates, updates
+ *  the view and notifies the form only once.
+ *
+ *  @param values An array of choice keys to select.
+ *
+ *  @param canUpdateView Whether the view should be updated.
+ */
+- (void)setFieldValues:(NSArray *)values canUpdateView:(BOOL)canUpdateView;
+
 /** Joins all the field values with a given string
  *
  *  A convenience method to return the selected field values
@@ -26,21 +26,29 @@
 
 #import "EZFormMultiRadioFormField.h"
 #import "EZForm+Private.h"
+#import "EZFormField+Private.h"
 
 @interface EZFormTextField (EZFormMultiRadioFieldPrivateAccess)
 - (void)updateUIWithValue:(NSString *)value;
 - (void)updateValidityIndicators;
 @end
 
-@interface EZFormRadioField (EZFormMultiRadioFormFieldPrivateAccess)
-- (NSArray *)orderedKeys;
-- (id)choiceValueForKey:(NSString *)key;
+@interface EZFormRadioField (EZFormMultiRadioFieldPrivateAccess)
+- (EZFormChoiceStore *)writableChoiceStore;
 @end
 
-@interface EZFormMultiRadioFormField ()
-@property (nonatomic, strong) NSMutableArray *selectedChoiceKeys;
+@interface EZFormMultiRadioFormField () {
+    NSArray *selectedChoiceKeysSnapshot;	// immutable copy of selectedChoiceKeys, nil when stale
+    NSMutableString *displayString;		// display values joined by ", ", nil when stale
+    NSUInteger displayStringChoiceChangeCount;
+}
+
+@property (nonatomic, strong) NSMutableOrderedSet *selectedChoiceKeys;
+
 @end
 
+static NSString * const EZFormMultiRadioDisplaySeparator = @", ";
+
 @implementation EZFormMultiRadioFormField
 @dynamic fieldValue;
 
@@ -48,15 +56,11 @@
 
 - (NSString *)fieldValuesJoinedByString:(NSString *)separator
 {
-    NSMutableArray *fieldValues = [NSMutableArray array];
-    [self.selectedChoiceKeys enumerateObjectsUsingBlock:^(id obj, __unused NSUInteger idx, __unused BOOL *stop) {
-        id keyValue = [self choiceValueForKey:obj];
-        if (keyValue) {
-            [fieldValues addObject:keyValue];
-        }
-    }];
-
-    return [fieldValues componentsJoinedByString:separator];
+    if ([separator isEqualToString:EZFormMultiRadioDisplaySeparator]) {
+        return [[self currentDisplayString] copy];
+    }
+    
+    return [self joinedDisplayValuesWithSeparator:separator];
 }
 
 - (void)unsetFieldValue:(id)value
@@ -67,50 +71,157 @@
 - (void)unsetAllFieldValues
 {
     [self.selectedChoiceKeys removeAllObjects];
+    [self selectionDidChange];
+    [displayString setString:@""];
+    [self fieldValueDidChange];
 }
 
 - (void)unsetFieldValue:(id)value canUpdateView:(BOOL)canUpdateView
 {
     [self unsetActualFieldValue:value];
+    [self fieldValueDidChange];
 
     if (self.mutuallyExclusiveChoice && [self.selectedChoiceKeys count] == 0 && ![value isEqual:self.mutuallyExclusiveChoice]) {
         self.fieldValue = self.mutuallyExclusiveChoice;
     }
 
-    if (canUpdateView && [(id<EZFormFieldConcrete>)self respondsToSelector:@selector(updateView)]) {
-        [(id<EZFormFieldConcrete>)self updateView];
+    __strong EZForm *form = self.form;
+    if (canUpdateView && [(id<EZFormFieldConcrete>)self respondsToSelector:@selector(updateView)] && ![form deferViewUpdateForFormField:self]) {
+        [self performUpdateView];
     }
 
-    __strong EZForm *form = self.form;
     [form formFieldDidChangeValue:self];
 }
 
 - (void)unsetActualFieldValue:(id)value
 {
-    BOOL containedValue = [self.selectedChoiceKeys containsObject:value];
-    if (containedValue) {
+    if ([self.selectedChoiceKeys containsObject:value]) {
         [self.selectedChoiceKeys removeObject:value];
+        [self selectionDidChange];
+        displayString = nil; // rebuilt on next use
+    }
+}
+
+- (void)setFieldValues:(NSArray *)values canUpdateView:(BOOL)canUpdateView
+{
+    for (id value in values) {
+        [self selectChoiceKey:value];
+    }
+    [self fieldValueDidChange];
+    
+    __strong EZForm *form = self.form;
+    if (canUpdateView && [(id<EZFormFieldConcrete>)self respondsToSelector:@selector(updateView)] && ![form deferViewUpdateForFormField:self]) {
+        [self performUpdateView];
+    }
+    
+    [form formFieldDidChangeValue:self];
+}
+
+
+#pragma mark - Selection
+
+- (void)selectChoiceKey:(id)key
+{
+    if (self.mutuallyExclusiveChoice != nil && [key isEqual:self.mutuallyExclusiveChoice]) {
+        [self.selectedChoiceKeys removeAllObjects];
+        [displayString setString:@""];
+    }
+    else if ([self.selectedChoiceKeys containsObject:self.mutuallyExclusiveChoice]) {
+        [self unsetActualFieldValue:self.mutuallyExclusiveChoice];
+    }
+    
+    if (![self.selectedChoiceKeys containsObject:key]) {
+        [self.selectedChoiceKeys addObject:key];
+        [self appendDisplayValueForKey:key];
+    }
+    [self selectionDidChange];
+}
+
+- (void)selectionDidChange
+{
+    selectedChoiceKeysSnapshot = nil;
+}
+
+
+#pragma mark - Display string
+
+- (NSString *)joinedDisplayValuesWithSeparator:(NSString *)separator
+{
+    NSMutableArray *fieldValues = [NSMutableArray arrayWithCapacity:[self.selectedChoiceKeys count]];
+    for (id key in self.selectedChoiceKeys) {
+        id keyValue = [self choiceValueForKey:key];
+        if (keyValue) {
+            [fieldValues addObject:keyValue];
+        }
+    }
+    
+    return [fieldValues componentsJoinedByString:separator];
+}
+
+/* The display string is extended as choices are selected, and only
+ * rebuilt from scratch after a choice is deselected or the choices
+ * change.
+ */
+- (NSMutableString *)currentDisplayString
+{
+    if (displayStringChoiceChangeCount != self.choiceStore.changeCount) {
+        displayString = nil;
+    }
+    if (nil == displayString) {
+        displayString = [[self joinedDisplayValuesWithSeparator:EZFormMultiRadioDisplaySeparator] mutableCopy];
+        displayStringChoiceChangeCount = self.choiceStore.changeCount;
     }
+    return displayString;
+}
+
+- (void)appendDisplayValueForKey:(id)key
+{
+    if (nil == displayString) return;
+    
+    id keyValue = [self choiceValueForKey:key];
+    if (keyValue) {
+        if ([displayString length] > 0) {
+            [displayString appendString:EZFormMultiRadioDisplaySeparator];
+        }
+        [displayString appendString:[keyValue description]];
+    }
+}
+
+
+#pragma mark - EZFormRadioField
+
+- (void)setChoiceStore:(EZFormChoiceStore *)choiceStore
+{
+    [super setChoiceStore:choiceStore];
+    displayString = nil;
+}
+
+- (void)setChoiceDataSource:(id<EZFormChoiceDataSource>)choiceDataSource
+{
+    [super setChoiceDataSource:choiceDataSource];
+    displayString = nil;
+}
+
+- (void)reloadChoices
+{
+    [super reloadChoices];
+    displayString = nil;
 }
 
+
 #pragma mark - EZFormField
 
 - (id)fieldValue
 {
-    return self.selectedChoiceKeys;
+    if (nil == selectedChoiceKeysSnapshot) {
+        selectedChoiceKeysSnapshot = [[self.selectedChoiceKeys array] copy];
+    }
+    return selectedChoiceKeysSnapshot;
 }
 
 - (void)setActualFieldValue:(id)value {
     if (value) {
-        if (self.mutuallyExclusiveChoice != nil && [value isEqual:self.mutuallyExclusiveChoice]) {
-            [self unsetAllFieldValues];
-        }
-        else if ([self.selectedChoiceKeys containsObject:self.mutuallyExclusiveChoice]) {
-            [self unsetFieldValue:self.mutuallyExclusiveChoice canUpdateView:NO];
-        }
-        if (![self.selectedChoiceKeys containsObject:value]) {
-            [self.selectedChoiceKeys addObject:value];
-        }
+        [self selectChoiceKey:value];
     }
     else {
         [self unsetAllFieldValues];
@@ -122,42 +233,21 @@
 
 - (void)setModelValue:(id)modelValue canUpdateView:(BOOL)canUpdateView
 {
-    if (self.valueTransformer != nil) {
-        modelValue = [self.valueTransformer transformedValue:modelValue];
-    }
+    modelValue = [self transformedValueForModelValue:modelValue];
     
     if ([modelValue isKindOfClass:[NSArray class]]) {
-        for (id key in ((NSArray *)modelValue)) {
-            [self setFieldValue:key canUpdateView:canUpdateView];
-        }
+        [self setFieldValues:(NSArray *)modelValue canUpdateView:canUpdateView];
     
     } else if ([modelValue isKindOfClass:[NSDictionary class]]) {
         
         NSDictionary *dictionaryModelValue = (NSDictionary *)modelValue;
         
-        // compile new choices array
-        NSMutableArray *keys = [NSMutableArray array];
-        NSMutableArray *values = [NSMutableArray array];
-        
-        // save existing keys and values
-        [keys addObjectsFromArray:self.choices.allKeys];
-        for (id key in self.orderedKeys) {
-            [values addObject:[self.choices objectForKey:key]];
-        }
-        
-        // now add in the new one
-        for (id key in dictionaryModelValue) {
-            [keys addObject:key];
-            [values addObject:[dictionaryModelValue objectForKey:key]];
-        }
-        
-        // now update those keys
-        [self setChoicesFromKeys:keys values:values];
+        // merge the new choices into the existing ones
+        NSArray *keys = [dictionaryModelValue allKeys];
+        [[self writableChoiceStore] addChoicesWithKeys:keys values:[dictionaryModelValue objectsForKeys:keys notFoundMarker:[NSNull null]]];
         
         // and update the value
-        for (id key in [dictionaryModelValue allKeys]) {
-            [self setFieldValue:key canUpdateView:canUpdateView];
-        }
+        [self setFieldValues:keys canUpdateView:canUpdateView];
         
     } else {
         [self setFieldValue:modelValue canUpdateView:canUpdateView];
@@ -168,7 +258,7 @@
 
 - (void)updateView
 {
-    NSString *fieldValue = [self fieldValuesJoinedByString:@", "];
+    NSString *fieldValue = [self fieldValuesJoinedByString:EZFormMultiRadioDisplaySeparator];
     [self updateUIWithValue:fieldValue];
 }
 
@@ -192,7 +282,7 @@
 - (instancetype)initWithKey:(NSString *)aKey
 {
     if ((self = [super initWithKey:aKey])) {
-        self.selectedChoiceKeys = [NSMutableArray array];
+        self.selectedChoiceKeys = [NSMutableOrderedSet orderedSet];
     }
 
     return self;
@@ -64,4 +64,13 @@
 
 @property (nonatomic, assign) BOOL allowsMultipleSelection;
 
+/** Whether to show a search bar above the choices.
+ *
+ *  As the user types, the choices are filtered using
+ *  -[EZFormRadioField choiceKeysMatchingSearchString:].
+ *
+ *  Must be set before the view is loaded. Default is NO.
+ */
+@property (nonatomic, assign) BOOL showsSearchBar;
+
 @end
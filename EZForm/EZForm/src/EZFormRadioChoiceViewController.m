@@ -24,12 +24,43 @@
 
 #import "EZFormRadioChoiceViewController.h"
 
+@interface EZFormRadioChoiceViewController () <UISearchBarDelegate>
+@property (nonatomic, strong) UISearchBar *searchBar;
+@property (nonatomic, copy) NSString *searchText;
+@property (nonatomic, copy) NSArray *filteredChoiceKeys;	// nil when not filtering
+@property (nonatomic, copy) NSSet *selectedChoiceKeys;		// snapshot of the field selection, nil when stale
+@end
+
 @implementation EZFormRadioChoiceViewController
 
 - (void)viewDidLoad
 {
     [super viewDidLoad];
     self.tableView.allowsMultipleSelection = self.allowsMultipleSelection;
+    
+    if (self.showsSearchBar) {
+	self.searchBar = [[UISearchBar alloc] initWithFrame:CGRectMake(0.0f, 0.0f, CGRectGetWidth(self.tableView.bounds), 44.0f)];
+	self.searchBar.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+	self.searchBar.delegate = self;
+	self.tableView.tableHeaderView = self.searchBar;
+    }
+    
+    NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+    [notificationCenter addObserver:self selector:@selector(choicesDidChangeNotification:) name:EZFormRadioFieldChoicesDidChangeNotification object:nil];
+    [notificationCenter addObserver:self selector:@selector(choicesDidChangeNotification:) name:EZFormChoiceStoreDidChangeNotification object:nil];
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)viewWillAppear:(BOOL)animated
+{
+    [super viewWillAppear:animated];
+    
+    // The selection may have changed while the view was off screen
+    self.selectedChoiceKeys = nil;
 }
 
 - (BOOL)shouldAutorotate
@@ -72,8 +103,12 @@
 {
     #pragma unused(tableView, section)
 
+    if (self.filteredChoiceKeys) {
+	return (NSInteger)[self.filteredChoiceKeys count];
+    }
+    
     EZFormRadioField *field = [self.form formFieldForKey:self.radioFieldKey];
-    return (NSInteger)[field.choices count];
+    return (NSInteger)[field numberOfChoices];
 }
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
@@ -86,20 +121,16 @@
     }
     
     EZFormRadioField *field = [self.form formFieldForKey:self.radioFieldKey];
-    NSString *choiceKey = [field choiceKeys][(NSUInteger)indexPath.row];
-    cell.textLabel.text = [field.choices valueForKey:choiceKey];
-
-    id modelValueArray = [self.form modelValueForKey:self.radioFieldKey];
-    if (modelValueArray != nil && ![modelValueArray isKindOfClass:[NSArray class]]) {
-        modelValueArray = @[modelValueArray];
-    }
-
-    if ([(NSArray *)modelValueArray containsObject:choiceKey]) {
-        cell.accessoryType = UITableViewCellAccessoryCheckmark;
+    NSString *choiceKey = [self choiceKeyAtIndexPath:indexPath];
+    if (self.filteredChoiceKeys) {
+	cell.textLabel.text = [field choiceValueForKey:choiceKey];
     }
     else {
-        cell.accessoryType = UITableViewCellAccessoryNone;
+	cell.textLabel.text = [field choiceValueAtIndex:(NSUInteger)indexPath.row];
     }
+
+    BOOL selected = [[self currentSelectedChoiceKeys] containsObject:choiceKey];
+    cell.accessoryType = (selected ? UITableViewCellAccessoryCheckmark : UITableViewCellAccessoryNone);
     
     return cell;
 }
@@ -110,14 +141,9 @@
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
     EZFormRadioField *field = [self.form formFieldForKey:self.radioFieldKey];
-    NSString *choiceKey = [field choiceKeys][(NSUInteger)indexPath.row];
-
-    id modelValueArray = [self.form modelValueForKey:self.radioFieldKey];
-    if (modelValueArray != nil && ![modelValueArray isKindOfClass:[NSArray class]]) {
-        modelValueArray = @[modelValueArray];
-    }
+    NSString *choiceKey = [self choiceKeyAtIndexPath:indexPath];
 
-    if (self.allowsMultipleSelection && [modelValueArray containsObject:choiceKey]) {
+    if (self.allowsMultipleSelection && [[self currentSelectedChoiceKeys] containsObject:choiceKey]) {
         [(EZFormMultiRadioFormField *)field unsetFieldValue:choiceKey];
     }
     else {
@@ -130,35 +156,119 @@
 }
 
 
-#pragma mark - Update cell checkmarks
+#pragma mark - Choices
 
-- (void)updateCellCheckmarks
+- (NSString *)choiceKeyAtIndexPath:(NSIndexPath *)indexPath
 {
-    id modelValueArray = [self.form modelValueForKey:self.radioFieldKey];
-    if (modelValueArray != nil && ![modelValueArray isKindOfClass:[NSArray class]]) {
-        modelValueArray = @[modelValueArray];
+    if (self.filteredChoiceKeys) {
+	return self.filteredChoiceKeys[(NSUInteger)indexPath.row];
     }
+    
+    EZFormRadioField *field = [self.form formFieldForKey:self.radioFieldKey];
+    return [field choiceKeyAtIndex:(NSUInteger)indexPath.row];
+}
+
+/* Sets filteredChoiceKeys to the keys of the choices matching the search
+ * text, or to nil when not filtering. Rows are looked up in the result
+ * until the next search, so the table must be reloaded after calling this.
+ */
+- (void)filterChoicesWithSearchText:(NSString *)searchText
+{
+    self.searchText = searchText;
+    if ([searchText length] > 0) {
+	EZFormRadioField *field = [self.form formFieldForKey:self.radioFieldKey];
+	self.filteredChoiceKeys = [field choiceKeysMatchingSearchString:searchText];
+    }
+    else {
+	self.filteredChoiceKeys = nil;
+    }
+}
 
+/* The field's choices were replaced, reloaded or edited: run the search
+ * again and reload the table in the same turn, so the row count and the
+ * rows never disagree.
+ */
+- (void)choicesDidChangeNotification:(NSNotification *)notification
+{
     EZFormRadioField *field = [self.form formFieldForKey:self.radioFieldKey];
-    NSArray *choiceKeys = [field choiceKeys];
+    if (notification.object != field && notification.object != field.choiceStore) return;
+    
+    if (self.filteredChoiceKeys) {
+	[self filterChoicesWithSearchText:self.searchText];
+    }
+    self.selectedChoiceKeys = nil;
+    [self.tableView reloadData];
+}
+
+
+#pragma mark - UISearchBarDelegate
+
+- (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText
+{
+    #pragma unused(searchBar)
     
-    for (UITableViewCell *cell in [self.tableView visibleCells]) {
-        NSIndexPath *indexPath = [self.tableView indexPathForCell:cell];
-        NSString *choiceKey = choiceKeys[(NSUInteger)indexPath.row];
-        __block BOOL selected = NO;
-
-        [(NSArray *)modelValueArray enumerateObjectsUsingBlock:^(id selection, __unused NSUInteger idx, BOOL *stop) {
-            if ([selection isEqualToString:choiceKey]) {
-                selected = YES;
-                *stop = YES;
-            }
-        }];
-        if (selected) {
-	    cell.accessoryType = UITableViewCellAccessoryCheckmark;
-        }
-        else {
-	    cell.accessoryType = UITableViewCellAccessoryNone;
-        }
+    [self filterChoicesWithSearchText:searchText];
+    [self.tableView reloadData];
+}
+
+- (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar
+{
+    [searchBar resignFirstResponder];
+}
+
+
+#pragma mark - Selection snapshot
+
+/* The selected keys are read from the form once per change and kept in
+ * a set, so configuring a cell is a constant time lookup.
+ */
+- (NSSet *)currentSelectedChoiceKeys
+{
+    if (nil == self.selectedChoiceKeys) {
+	id modelValue = [self.form modelValueForKey:self.radioFieldKey];
+	if (nil == modelValue) {
+	    self.selectedChoiceKeys = [NSSet set];
+	}
+	else if ([modelValue isKindOfClass:[NSArray class]]) {
+	    self.selectedChoiceKeys = [NSSet setWithArray:modelValue];
+	}
+	else {
+	    self.selectedChoiceKeys = [NSSet setWithObject:modelValue];
+	}
+    }
+    return self.selectedChoiceKeys;
+}
+
+
+#pragma mark - Update cell checkmarks
+
+- (void)updateCellCheckmarks
+{
+    NSSet *previousSelectedChoiceKeys = self.selectedChoiceKeys;
+    self.selectedChoiceKeys = nil;
+    NSSet *selectedChoiceKeys = [self currentSelectedChoiceKeys];
+    
+    // Only rows whose selection state changed need updating
+    NSMutableSet *changedChoiceKeys = nil;
+    if (previousSelectedChoiceKeys) {
+	changedChoiceKeys = [previousSelectedChoiceKeys mutableCopy];
+	[changedChoiceKeys minusSet:selectedChoiceKeys];
+	NSMutableSet *addedChoiceKeys = [selectedChoiceKeys mutableCopy];
+	[addedChoiceKeys minusSet:previousSelectedChoiceKeys];
+	[changedChoiceKeys unionSet:addedChoiceKeys];
+	
+	if ([changedChoiceKeys count] == 0) return;
+    }
+    
+    for (NSIndexPath *indexPath in [self.tableView indexPathsForVisibleRows]) {
+        NSString *choiceKey = [self choiceKeyAtIndexPath:indexPath];
+	if (changedChoiceKeys && ![changedChoiceKeys containsObject:choiceKey]) {
+	    continue;
+	}
+	
+	UITableViewCell *cell = [self.tableView cellForRowAtIndexPath:indexPath];
+	BOOL selected = [selectedChoiceKeys containsObject:choiceKey];
+	cell.accessoryType = (selected ? UITableViewCellAccessoryCheckmark : UITableViewCellAccessoryNone);
     }
 }
 
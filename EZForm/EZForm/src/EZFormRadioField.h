@@ -24,7 +24,15 @@
 
 #import <Foundation/Foundation.h>
 #import "EZFormTextField.h"
+#import "EZFormChoiceStore.h"
+#import "EZFormChoiceDataSource.h"
 
+/** Posted when a radio field's choices are replaced or reloaded: when its
+ *  choice store or choice data source is set, or reloadChoices is called.
+ *  The notification object is the field. Changes made to the choice store
+ *  itself post EZFormChoiceStoreDidChangeNotification instead.
+ */
+extern NSString * const EZFormRadioFieldChoicesDidChangeNotification;
 
 /** A form field to handle selection from multiple choices.
  *
@@ -56,6 +64,83 @@
  */
 @property (nonatomic, strong) NSDictionary *choices;
 
+/** The store holding the choices of the field.
+ *
+ *  Choices set with choices, setChoicesFromArray: or
+ *  setChoicesFromKeys:values: are kept in a choice store, which looks
+ *  up choices by key in constant time. A store can also be assigned
+ *  directly, for example one with integer keys.
+ */
+@property (nonatomic, strong) EZFormChoiceStore *choiceStore;
+
+/** Assigns a choice store that is shared with other fields, without
+ *  copying it.
+ *
+ *  The first time the field itself would add choices to the store, for
+ *  example when given a dictionary model value, it copies the store
+ *  first and leaves the shared one unchanged. Forms made from an
+ *  EZFormTemplate share choice stores this way.
+ *
+ *  @param choiceStore A choice store that should not be modified.
+ */
+- (void)setSharedChoiceStore:(EZFormChoiceStore *)choiceStore;
+
+/** A data source to fetch choices from on demand, instead of the
+ *  choice store.
+ *
+ *  When set, choices are fetched a page at a time as they are needed,
+ *  and only a bounded number of recently used pages are kept in memory.
+ *  Use the choice accessors below (numberOfChoices, choiceKeyAtIndex:,
+ *  etc.) rather than choices or choiceKeys, which would fetch every
+ *  choice.
+ *
+ *  Default is nil (choices come from choiceStore).
+ */
+@property (nonatomic, strong) id<EZFormChoiceDataSource> choiceDataSource;
+
+/** Discards choices cached from the choice data source and revalidates
+ *  the field.
+ *
+ *  Call when the choices provided by the data source change.
+ */
+- (void)reloadChoices;
+
+/** Returns the number of choices.
+ */
+@property (nonatomic, readonly) NSUInteger numberOfChoices;
+
+/** Returns the key of the choice at an index.
+ *
+ *  @param index An index less than numberOfChoices.
+ *
+ *  @returns The choice key.
+ */
+- (id)choiceKeyAtIndex:(NSUInteger)index;
+
+/** Returns the display value of the choice at an index.
+ *
+ *  @param index An index less than numberOfChoices.
+ *
+ *  @returns The choice value.
+ */
+- (id)choiceValueAtIndex:(NSUInteger)index;
+
+/** Returns the display value of the choice with a key.
+ *
+ *  @param key A choice key, or nil for the unselected value.
+ *
+ *  @returns The choice value, or nil if there is no choice with the key.
+ */
+- (id)choiceValueForKey:(id)key;
+
+/** Returns the index of the choice with a key.
+ *
+ *  @param key A choice key.
+ *
+ *  @returns The index of the choice, or NSNotFound.
+ */
+- (NSUInteger)indexOfChoiceKey:(id)key;
+
 /** Set a value to display when no choice has been selected.
  *
  */
@@ -104,8 +189,27 @@
  */
 - (void)setChoicesFromKeys:(NSArray *)keys values:(NSArray *)values;
 
+/** Returns the keys of choices whose display values match a search
+ *  string, in choice order.
+ *
+ *  Matching ignores case and diacritics; each word of the search string
+ *  must be a prefix of a word of the display value. If the choice data
+ *  source implements choiceKeysMatchingSearchString:, searching is left
+ *  to it. A data source that does not is never fetched from to search:
+ *  only the choices in pages it has already provided are searched.
+ *  Without a data source, an EZFormChoiceSearchIndex is built over the
+ *  choices on the first search, and reused until the choices change.
+ *
+ *  @param searchString The text to search for. An empty string matches
+ *  all choices.
+ *
+ *  @returns An array of matching choice keys.
+ */
+- (NSArray *)choiceKeysMatchingSearchString:(NSString *)searchString;
+
 /** Returns the keys of all choices.
  *
+ *  With a choice data source, all choices are fetched.
  */
 @property (nonatomic, readonly, copy) NSArray *choiceKeys;
 
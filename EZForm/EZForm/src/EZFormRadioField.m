@@ -24,6 +24,11 @@
 
 #import "EZFormRadioField.h"
 #import "EZForm+Private.h"
+#import "EZFormField+Private.h"
+#import "EZFormChoicePageCache.h"
+#import "EZFormChoiceSearchIndex.h"
+
+NSString * const EZFormRadioFieldChoicesDidChangeNotification = @"EZFormRadioFieldChoicesDidChangeNotification";
 
 
 #pragma mark - External Class Categories
@@ -42,7 +47,10 @@
 
 @interface EZFormRadioField () <UIPickerViewDataSource, UIPickerViewDelegate>
 
-@property (nonatomic, copy) NSArray *orderedKeys;
+@property (nonatomic, strong) EZFormChoicePageCache *choicePageCache;
+@property (nonatomic, strong) EZFormChoiceSearchIndex *choiceSearchIndex;
+@property (nonatomic, assign) NSUInteger choiceSearchIndexChangeCount;
+@property (nonatomic, assign) BOOL choiceStoreShared;
 
 @end
 
@@ -63,20 +71,175 @@
 
 - (void)setChoicesFromKeys:(NSArray *)keys values:(NSArray *)values
 {
-    _choices = [NSDictionary dictionaryWithObjects:values forKeys:keys];
-    self.orderedKeys = keys; // preserve order specified by user
+    // preserve order specified by user
+    self.choiceStore = [[EZFormChoiceStore alloc] initWithKeys:keys values:values];
 }
 
 - (void)setChoices:(NSDictionary *)newChoices
 {
-    _choices = newChoices;
+    NSArray *keys = [newChoices allKeys];
+    NSArray *values = [newChoices objectsForKeys:keys notFoundMarker:[NSNull null]];
+    self.choiceStore = [[EZFormChoiceStore alloc] initWithKeys:keys values:values];
+}
+
+- (NSDictionary *)choices
+{
+    if (self.choiceDataSource) {
+	NSArray *keys = nil;
+	NSArray *values = nil;
+	[self.choiceDataSource getChoiceKeys:&keys values:&values inRange:NSMakeRange(0, [self.choiceDataSource numberOfChoices])];
+	return [NSDictionary dictionaryWithObjects:values forKeys:keys];
+    }
+    return [self.choiceStore dictionaryRepresentation];
+}
+
+- (void)setChoiceStore:(EZFormChoiceStore *)choiceStore
+{
+    _choiceStore = choiceStore;
+    self.choiceStoreShared = NO;
+    self.choiceSearchIndex = nil;
+    [self choicesDidReload];
+}
+
+- (void)setSharedChoiceStore:(EZFormChoiceStore *)choiceStore
+{
+    self.choiceStore = choiceStore;
+    self.choiceStoreShared = YES;
+}
+
+/* The choice store, copied first if it is shared, for adding choices.
+ */
+- (EZFormChoiceStore *)writableChoiceStore
+{
+    if (self.choiceStoreShared) {
+	self.choiceStore = [self.choiceStore copy];
+    }
+    return self.choiceStore;
+}
+
+- (void)setChoiceDataSource:(id<EZFormChoiceDataSource>)choiceDataSource
+{
+    _choiceDataSource = choiceDataSource;
+    self.choicePageCache = (choiceDataSource ? [[EZFormChoicePageCache alloc] initWithDataSource:choiceDataSource] : nil);
+    self.choiceSearchIndex = nil;
+    [self choicesDidReload];
+}
+
+- (void)reloadChoices
+{
+    [self.choicePageCache removeAllPages];
+    self.choiceSearchIndex = nil;
+    [self choicesDidReload];
+}
+
+- (void)choicesDidReload
+{
+    [self setNeedsValidation];
+    [[NSNotificationCenter defaultCenter] postNotificationName:EZFormRadioFieldChoicesDidChangeNotification object:self];
+}
+
+- (NSArray *)choiceKeysMatchingSearchString:(NSString *)searchString
+{
+    if ([self.choiceDataSource respondsToSelector:@selector(choiceKeysMatchingSearchString:)]) {
+	return [self.choiceDataSource choiceKeysMatchingSearchString:searchString];
+    }
     
-    self.orderedKeys = [newChoices allKeys];
+    /* Fetching every choice of a data source to search it would defeat
+     * paging, so only the choices already fetched are searched. The pages
+     * in the cache come and go, and are few, so they are not indexed.
+     */
+    if (self.choicePageCache) {
+	NSArray *keys = nil;
+	NSArray *values = nil;
+	[self.choicePageCache getCachedChoiceKeys:&keys values:&values];
+	EZFormChoiceSearchIndex *cachedChoiceSearchIndex = [[EZFormChoiceSearchIndex alloc] initWithKeys:keys values:values];
+	return [cachedChoiceSearchIndex keysOfChoicesMatchingSearchString:searchString];
+    }
+    
+    if (nil == self.choiceSearchIndex || self.choiceSearchIndexChangeCount != self.choiceStore.changeCount) {
+	NSArray *keys = nil;
+	NSArray *values = nil;
+	[self.choiceStore getChoiceKeys:&keys values:&values inRange:NSMakeRange(0, [self.choiceStore count])];
+	self.choiceSearchIndex = [[EZFormChoiceSearchIndex alloc] initWithKeys:keys values:values];
+	self.choiceSearchIndexChangeCount = self.choiceStore.changeCount;
+    }
+    
+    return [self.choiceSearchIndex keysOfChoicesMatchingSearchString:searchString];
 }
 
 - (NSArray *)choiceKeys
 {
-    return self.orderedKeys;
+    if (self.choiceDataSource) {
+	NSArray *keys = nil;
+	[self.choiceDataSource getChoiceKeys:&keys values:NULL inRange:NSMakeRange(0, [self.choiceDataSource numberOfChoices])];
+	return keys;
+    }
+    return [self.choiceStore allKeys];
+}
+
+- (NSUInteger)numberOfChoices
+{
+    if (self.choicePageCache) {
+	return [self.choicePageCache count];
+    }
+    return [self.choiceStore count];
+}
+
+- (id)choiceKeyAtIndex:(NSUInteger)index
+{
+    if (self.choicePageCache) {
+	return [self.choicePageCache keyAtIndex:index];
+    }
+    return [self.choiceStore keyAtIndex:index];
+}
+
+- (id)choiceValueAtIndex:(NSUInteger)index
+{
+    if (self.choicePageCache) {
+	return [self.choicePageCache valueAtIndex:index];
+    }
+    return [self.choiceStore valueAtIndex:index];
+}
+
+- (id)choiceValueForKey:(id)key
+{
+    id value;
+    if (nil == key) {
+	value = self.unselected;
+    }
+    else if (self.choiceDataSource) {
+	value = [self.choiceDataSource choiceValueForKey:key];
+    }
+    else {
+	value = [self.choiceStore choiceValueForKey:key];
+    }
+    return value;
+}
+
+- (NSUInteger)indexOfChoiceKey:(id)key
+{
+    if (self.choiceDataSource) {
+	if ([self.choiceDataSource respondsToSelector:@selector(indexOfChoiceKey:)]) {
+	    return [self.choiceDataSource indexOfChoiceKey:key];
+	}
+	return NSNotFound;
+    }
+    return [self.choiceStore indexOfKey:key];
+}
+
+
+#pragma mark - Validation rules
+
+- (void)setValidationRequiresSelection:(BOOL)validationRequiresSelection
+{
+    _validationRequiresSelection = validationRequiresSelection;
+    [self setNeedsValidation];
+}
+
+- (void)setValidationRestrictedToChoiceValues:(BOOL)validationRestrictedToChoiceValues
+{
+    _validationRestrictedToChoiceValues = validationRestrictedToChoiceValues;
+    [self setNeedsValidation];
 }
 
 
@@ -89,7 +252,7 @@
     if (self.validationRequiresSelection && nil == self.fieldValue) {
 	result = NO;
     }
-    else if (self.validationRestrictedToChoiceValues && ![[self.choices allKeys] containsObject:self.fieldValue]) {
+    else if (self.validationRestrictedToChoiceValues && (nil == self.fieldValue || nil == [self choiceValueForKey:self.fieldValue])) {
 	result = NO;
     }
     
@@ -135,32 +298,16 @@
 
 - (void)setModelValue:(id)modelValue canUpdateView:(BOOL)canUpdateView
 {
-    if (self.valueTransformer != nil) {
-        modelValue = [self.valueTransformer transformedValue:modelValue];
-    }
+    modelValue = [self transformedValueForModelValue:modelValue];
     
     if ([modelValue isKindOfClass:[NSDictionary class]]) {
 
         NSDictionary *dictionaryModelValue = (NSDictionary *)modelValue;
-
-        // compile new choices array
-        NSMutableArray *keys = [NSMutableArray array];
-        NSMutableArray *values = [NSMutableArray array];
-        
-        // save existing keys and values
-        [keys addObjectsFromArray:self.orderedKeys];
-        for (id key in self.orderedKeys) {
-            [values addObject:[self.choices objectForKey:key]];
-        }
-        
-        // now add in the new one
-        for (id key in dictionaryModelValue) {
-            [keys addObject:key];
-            [values addObject:[dictionaryModelValue objectForKey:key]];
-        }
         
-        // now update those keys
-        [self setChoicesFromKeys:keys values:values];
+        // merge the new choices into the existing ones
+        NSArray *keys = [dictionaryModelValue allKeys];
+        [[self writableChoiceStore] addChoicesWithKeys:keys values:[dictionaryModelValue objectsForKeys:keys notFoundMarker:[NSNull null]]];
+        [self setNeedsValidation];
         
         // and update the value
         [self setFieldValue:dictionaryModelValue.allKeys.firstObject canUpdateView:canUpdateView];
@@ -212,7 +359,7 @@
     if ([self.userView.inputView isKindOfClass:[UIPickerView class]]) {
 	UIPickerView *pickerView = (UIPickerView *)self.userView.inputView;
 	if (self.fieldValue) {
-	    NSUInteger index = [self.orderedKeys indexOfObject:self.fieldValue];
+	    NSUInteger index = [self indexOfChoiceKey:self.fieldValue];
 	    if (index != NSNotFound) {
 		if (self.unselected) index++;
 		if (index != (NSUInteger)[pickerView selectedRowInComponent:0]) {
@@ -234,18 +381,16 @@
 	    value = self.unselected;
 	}
 	else {
-	    NSString *key = self.orderedKeys[index - 1];
-	    value = [self.choices valueForKey:key];
+	    value = [self choiceValueAtIndex:index - 1];
 	}
     }
     else {
-	NSString *key = self.orderedKeys[index];
-	value = [self.choices valueForKey:key];
+	value = [self choiceValueAtIndex:index];
     }
     return value;
 }
 
-- (NSString *)choiceKeyAtIndex:(NSUInteger)index
+- (NSString *)choiceKeyOrUnselectedAtIndex:(NSUInteger)index
 {
     NSString *key = nil;
     if (self.unselected) {
@@ -253,27 +398,15 @@
 	    key = nil;
 	}
 	else {
-	    key = self.orderedKeys[index - 1];
+	    key = [self choiceKeyAtIndex:index - 1];
 	}
     }
     else {
-	key = self.orderedKeys[index];
+	key = [self choiceKeyAtIndex:index];
     }
     return key;
 }
 
-- (id)choiceValueForKey:(NSString *)key
-{
-    id value;
-    if (key) {
-	value = self.choices[key];
-    }
-    else {
-	value = self.unselected;
-    }
-    return value;
-}
-
 
 #pragma mark - UIPickerViewDataSource
 
@@ -284,7 +417,7 @@
 
 - (NSInteger)pickerView:(__unused UIPickerView *)pickerView numberOfRowsInComponent:(__unused NSInteger)component
 {
-    NSInteger rows = (NSInteger)[self.choices count];
+    NSInteger rows = (NSInteger)[self numberOfChoices];
     if (self.unselected) rows += 1;
     return rows;
 }
@@ -299,10 +432,22 @@
 
 - (void)pickerView:(__unused UIPickerView *)pickerView didSelectRow:(NSInteger)row inComponent:(__unused NSInteger)component
 {
-    NSString *key = [self choiceKeyAtIndex:(NSUInteger)row];
+    NSString *key = [self choiceKeyOrUnselectedAtIndex:(NSUInteger)row];
     _selectedChoiceKey = key;
     [self setFieldValue:key canUpdateView:YES];
     [self updateValidityIndicators];
 }
 
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithKey:(NSString *)aKey
+{
+    if ((self = [super initWithKey:aKey])) {
+	_choiceStore = [[EZFormChoiceStore alloc] init];
+    }
+    
+    return self;
+}
+
 @end
@@ -0,0 +1,93 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** An immutable snapshot of the model values of a form.
+ *
+ *  Snapshots are returned by -[EZForm modelSnapshot]. A snapshot only
+ *  stores the values of fields that changed since the previous snapshot
+ *  of the same form, and refers to that snapshot for every other value,
+ *  so taking a snapshot costs time proportional to the number of changed
+ *  fields rather than the number of fields in the form. Chains of
+ *  snapshots are merged as they grow, so looking up a value only walks a
+ *  few snapshots.
+ *
+ *  Every value in a snapshot records the version of the snapshot it was
+ *  taken in, so the keys changed between two snapshots of a form can be
+ *  found without comparing their values.
+ */
+@interface EZFormSnapshot : NSObject
+
+/** The version of the form model when the snapshot was taken.
+ *
+ *  Versions increase with every change to a field's model value, so a
+ *  snapshot with a greater version was taken after one with a smaller
+ *  version.
+ */
+@property (nonatomic, readonly) NSUInteger version;
+
+/** Returns the model value of a field at the time of the snapshot.
+ *
+ *  @param key The key of the field.
+ *
+ *  @returns The model value, or nil if the field had no value or was not
+ *  part of the form.
+ */
+- (id)modelValueForKey:(NSString *)key;
+
+/** A dictionary of all field key->value pairs at the time of the snapshot.
+ *
+ *  Unlike the other methods this walks every stored value, the first time
+ *  it is called.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *modelValues;
+
+/** Returns the keys of fields whose model value changed between an
+ *  earlier snapshot and the receiver.
+ *
+ *  A field counts as changed if its value was set, even to an equal
+ *  value, or if it was added to or removed from the form.
+ *
+ *  Costs time proportional to the number of changed fields.
+ *
+ *  @param snapshot An earlier snapshot of the same form, or nil to return
+ *  the keys of all fields.
+ *
+ *  @returns A set of field keys.
+ */
+- (NSSet *)changesSince:(EZFormSnapshot *)snapshot;
+
+/** Whether any field changed between an earlier snapshot and the receiver.
+ *
+ *  Takes constant time.
+ *
+ *  @param snapshot An earlier snapshot of the same form, or nil.
+ *
+ *  @returns YES if changesSince: would return any keys.
+ */
+- (BOOL)hasChangesSince:(EZFormSnapshot *)snapshot;
+
+@end
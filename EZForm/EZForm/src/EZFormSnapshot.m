@@ -0,0 +1,188 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormSnapshot.h"
+#import "EZForm.h"
+
+/* Snapshots deeper than this are merged into their parent, whatever the
+ * size of their changes, to bound the cost of value lookups.
+ */
+#define EZFormSnapshotMaximumDepth 32
+
+
+#pragma mark - EZFormSnapshotEntry
+
+/* The value of one field, and the version of the snapshot it was taken in.
+ * A nil value records a field without a value, or one that was removed.
+ */
+@interface EZFormSnapshotEntry : NSObject
+
+@property (nonatomic, readonly, strong) id value;
+@property (nonatomic, readonly) NSUInteger version;
+
+- (instancetype)initWithValue:(id)value version:(NSUInteger)version;
+
+@end
+
+@implementation EZFormSnapshotEntry
+
+- (instancetype)initWithValue:(id)value version:(NSUInteger)version
+{
+    if ((self = [super init])) {
+	_value = value;
+	_version = version;
+    }
+    
+    return self;
+}
+
+@end
+
+
+#pragma mark - EZFormSnapshot class extension
+
+@interface EZFormSnapshot ()
+
+@property (nonatomic, readwrite) NSUInteger version;
+@property (nonatomic, strong) EZFormSnapshot *parent;
+@property (nonatomic, copy) NSDictionary *entries;	// key -> EZFormSnapshotEntry, changed since parent
+@property (nonatomic, assign) NSUInteger depth;
+@property (nonatomic, strong) id lineage;		// shared by all snapshots of a form
+@property (nonatomic, readwrite, copy) NSDictionary *modelValues;
+
+@end
+
+
+#pragma mark - EZFormSnapshot implementation
+
+@implementation EZFormSnapshot
+
+/* Captures the values of changedKeys from form on top of parent.
+ *
+ * The new changes are merged into the parent's while the parent holds no
+ * more changes than the merged result, like carries in a binary counter.
+ * Each value is merged a logarithmic number of times and chains stay
+ * short. A chain that reaches its root this way becomes a new root.
+ */
++ (instancetype)snapshotWithParent:(EZFormSnapshot *)parent form:(EZForm *)form changedKeys:(id<NSFastEnumeration>)changedKeys version:(NSUInteger)version lineage:(id)lineage
+{
+    NSMutableDictionary *entries = [NSMutableDictionary dictionary];
+    for (NSString *key in changedKeys) {
+	entries[key] = [[EZFormSnapshotEntry alloc] initWithValue:[form modelValueForKey:key] version:version];
+    }
+    
+    EZFormSnapshot *ancestor = parent;
+    while (ancestor != nil && ([ancestor.entries count] <= [entries count] || ancestor.depth >= EZFormSnapshotMaximumDepth)) {
+	NSMutableDictionary *mergedEntries = [ancestor.entries mutableCopy];
+	[mergedEntries addEntriesFromDictionary:entries];
+	entries = mergedEntries;
+	ancestor = ancestor.parent;
+    }
+    
+    EZFormSnapshot *snapshot = [[self alloc] init];
+    snapshot.version = version;
+    snapshot.parent = ancestor;
+    snapshot.entries = entries;
+    snapshot.depth = (ancestor ? ancestor.depth + 1 : 0);
+    snapshot.lineage = lineage;
+    return snapshot;
+}
+
+- (id)modelValueForKey:(NSString *)key
+{
+    for (EZFormSnapshot *snapshot = self; snapshot != nil; snapshot = snapshot.parent) {
+	EZFormSnapshotEntry *entry = snapshot.entries[key];
+	if (entry) {
+	    return entry.value;
+	}
+    }
+    return nil;
+}
+
+- (NSDictionary *)modelValues
+{
+    if (nil == _modelValues) {
+	NSMutableDictionary *modelValues = [NSMutableDictionary dictionary];
+	NSMutableSet *seenKeys = [NSMutableSet set];
+	for (EZFormSnapshot *snapshot = self; snapshot != nil; snapshot = snapshot.parent) {
+	    [snapshot.entries enumerateKeysAndObjectsUsingBlock:^(NSString *key, EZFormSnapshotEntry *entry, __unused BOOL *stop) {
+		if (![seenKeys containsObject:key]) {
+		    [seenKeys addObject:key];
+		    [modelValues setValue:entry.value forKey:key];
+		}
+	    }];
+	}
+	_modelValues = [modelValues copy];
+    }
+    return _modelValues;
+}
+
+- (NSSet *)changesSince:(EZFormSnapshot *)snapshot
+{
+    if (nil == snapshot) {
+	return [NSSet setWithArray:[self.modelValues allKeys]];
+    }
+    
+    if (snapshot.lineage != self.lineage) {
+	NSException *exception = [NSException exceptionWithName:NSInvalidArgumentException reason:@"changesSince: called with a snapshot of a different form" userInfo:nil];
+	@throw exception;
+    }
+    
+    /* Each snapshot in the chain holds the changes made after its parent's
+     * version, so only snapshots newer than the earlier one are visited.
+     * Merged snapshots can also hold older changes, which are skipped.
+     */
+    NSUInteger sinceVersion = snapshot.version;
+    NSMutableSet *changedKeys = [NSMutableSet set];
+    for (EZFormSnapshot *aSnapshot = self; aSnapshot != nil && aSnapshot.version > sinceVersion; aSnapshot = aSnapshot.parent) {
+	[aSnapshot.entries enumerateKeysAndObjectsUsingBlock:^(NSString *key, EZFormSnapshotEntry *entry, __unused BOOL *stop) {
+	    if (entry.version > sinceVersion) {
+		[changedKeys addObject:key];
+	    }
+	}];
+    }
+    return changedKeys;
+}
+
+- (BOOL)hasChangesSince:(EZFormSnapshot *)snapshot
+{
+    if (nil == snapshot) {
+	return ([self.modelValues count] > 0);
+    }
+    
+    if (snapshot.lineage != self.lineage) {
+	NSException *exception = [NSException exceptionWithName:NSInvalidArgumentException reason:@"hasChangesSince: called with a snapshot of a different form" userInfo:nil];
+	@throw exception;
+    }
+    
+    // Snapshots are only taken after a change, so versions differ exactly when fields changed
+    return (self.version > snapshot.version);
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p version=%lu depth=%lu>", [self class], self, (unsigned long)self.version, (unsigned long)self.depth];
+}
+
+@end
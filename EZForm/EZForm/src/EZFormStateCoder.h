@@ -0,0 +1,151 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@class EZForm;
+
+
+/** Error domain of EZFormStateDecoder errors.
+ */
+extern NSString * const EZFormStateDecoderErrorDomain;
+
+typedef NS_ENUM(NSInteger, EZFormStateDecoderError) {
+    EZFormStateDecoderErrorCorruptData = 1,	// not EZForm state data, or truncated
+    EZFormStateDecoderErrorUnsupportedVersion,	// written by a newer encoder
+} ;
+
+
+/** Encodes form model values in a compact, versioned binary format.
+ *
+ *  Supported model values are strings, numbers (including booleans),
+ *  dates, data, NSNull, and arrays, sets, ordered sets and dictionaries
+ *  of them, such as multi-radio selections.
+ *
+ *  Every string, whether a field key or part of a value, is stored once
+ *  in a string table and referred to by index. Each field value is
+ *  length-prefixed, so an EZFormStateDecoder can decode any one field
+ *  without decoding the others.
+ */
+@interface EZFormStateEncoder : NSObject
+
+/** Encodes the model values of a form.
+ *
+ *  @param form The form to encode.
+ *
+ *  @returns The encoded data.
+ */
++ (NSData *)encodedDataWithForm:(EZForm *)form;
+
+/** Encodes model values.
+ *
+ *  @param modelValues A dictionary of model values, keyed by field key.
+ *
+ *  @returns The encoded data.
+ */
++ (NSData *)encodedDataWithModelValues:(NSDictionary *)modelValues;
+
+/** Adds the model value of a field to the encoded state.
+ *
+ *  Raises an NSInvalidArgumentException if the value, or any object it
+ *  contains, is not of a supported class.
+ *
+ *  @param value The model value, or nil.
+ *
+ *  @param key The field key.
+ */
+- (void)encodeModelValue:(id)value forKey:(NSString *)key;
+
+/** Adds several model values to the encoded state.
+ *
+ *  @param modelValues A dictionary of model values, keyed by field key.
+ */
+- (void)encodeModelValues:(NSDictionary *)modelValues;
+
+/** The encoded state of all model values added so far.
+ */
+@property (nonatomic, readonly, copy) NSData *encodedData;
+
+@end
+
+
+/** Decodes form state written by EZFormStateEncoder.
+ *
+ *  Only the string table and field directory are read up front. Each
+ *  field value is decoded the first time it is asked for, so restoring a
+ *  few fields of a large memory-mapped state file only touches the pages
+ *  holding those fields.
+ */
+@interface EZFormStateDecoder : NSObject
+
+/** Creates a decoder that reads a memory-mapped state file.
+ *
+ *  @param path The path of a file written with the encoded data of an
+ *  EZFormStateEncoder.
+ *
+ *  @param error On return, an error if the file could not be read or is
+ *  not valid.
+ *
+ *  @returns An EZFormStateDecoder object, or nil on error.
+ */
++ (instancetype)decoderWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/** Initialises a decoder with encoded data.
+ *
+ *  @param data The encoded data of an EZFormStateEncoder.
+ *
+ *  @param error On return, an error if the data is not valid.
+ *
+ *  @returns Initialised EZFormStateDecoder object, or nil on error.
+ */
+- (instancetype)initWithData:(NSData *)data error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+
+/** The encoded field keys, in the order they were encoded.
+ */
+@property (nonatomic, readonly, copy) NSArray *keys;
+
+/** Returns the decoded model value of a field.
+ *
+ *  @param key The field key.
+ *
+ *  @returns The model value, or nil if the field was not encoded, had no
+ *  value or its value is corrupt.
+ */
+- (id)modelValueForKey:(NSString *)key;
+
+/** A dictionary of all decoded model values, keyed by field key.
+ */
+@property (nonatomic, readonly, copy) NSDictionary *modelValues;
+
+/** Sets the decoded model values on the fields of a form.
+ *
+ *  Only values of fields in the form are decoded. They are set inside a
+ *  beginUpdates/endUpdates pair, so the form is validated and its delegate
+ *  notified once.
+ *
+ *  @param form The form to restore.
+ */
+- (void)restoreForm:(EZForm *)form;
+
+@end
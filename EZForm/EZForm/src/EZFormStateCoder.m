@@ -0,0 +1,590 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormStateCoder.h"
+#import "EZForm.h"
+
+NSString * const EZFormStateDecoderErrorDomain = @"EZFormStateDecoderErrorDomain";
+
+/* State layout. Counts, lengths and indexes are unsigned LEB128 varints:
+ *
+ *   "EZFS" uint8 version
+ *   string count, then each string as length and UTF-8 bytes
+ *   field count, then each field as key string index and value length
+ *   field values, in field order
+ *
+ * A value is a tag byte followed by its payload (see EZFormStateTag).
+ */
+static const char EZFormStateMagic[4] = {'E', 'Z', 'F', 'S'};
+static const uint8_t EZFormStateVersion = 1;
+
+#define EZFormStateHeaderLength 5
+#define EZFormStateMaximumNestingDepth 32
+
+typedef NS_ENUM(uint8_t, EZFormStateTag) {
+    EZFormStateTagNil = 0,
+    EZFormStateTagNull,
+    EZFormStateTagFalse,
+    EZFormStateTagTrue,
+    EZFormStateTagInteger,	// zigzag varint
+    EZFormStateTagUnsignedInteger,	// varint, for values beyond INT64_MAX
+    EZFormStateTagDouble,	// 8 bytes, little endian
+    EZFormStateTagString,	// varint string index
+    EZFormStateTagDate,		// double timeIntervalSinceReferenceDate
+    EZFormStateTagData,		// varint length, bytes
+    EZFormStateTagArray,	// varint count, values
+    EZFormStateTagSet,		// varint count, values
+    EZFormStateTagOrderedSet,	// varint count, values
+    EZFormStateTagDictionary,	// varint count, key and value pairs
+} ;
+
+
+#pragma mark - Varints
+
+static void
+EZFormStateAppendVarint(NSMutableData *data, uint64_t value)
+{
+    uint8_t buffer[10];
+    NSUInteger length = 0;
+    do {
+	uint8_t byte = (uint8_t)(value & 0x7f);
+	value >>= 7;
+	buffer[length++] = (value ? (byte | 0x80) : byte);
+    } while (value);
+    [data appendBytes:buffer length:length];
+}
+
+static BOOL
+EZFormStateReadVarint(const uint8_t *bytes, NSUInteger end, NSUInteger *offset, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (unsigned int shift = 0; shift < 64 && *offset < end; shift += 7) {
+	uint8_t byte = bytes[(*offset)++];
+	result |= (uint64_t)(byte & 0x7f) << shift;
+	if ((byte & 0x80) == 0) {
+	    *value = result;
+	    return YES;
+	}
+    }
+    return NO;
+}
+
+static BOOL
+EZFormStateReadCount(const uint8_t *bytes, NSUInteger end, NSUInteger *offset, NSUInteger *count)
+{
+    uint64_t value;
+    if (!EZFormStateReadVarint(bytes, end, offset, &value) || value > end) {
+	// No count or length can exceed the number of bytes
+	return NO;
+    }
+    *count = (NSUInteger)value;
+    return YES;
+}
+
+
+#pragma mark - EZFormStateEncoder class extension
+
+@interface EZFormStateEncoder ()
+
+@property (nonatomic, strong) NSMutableArray *strings;
+@property (nonatomic, strong) NSMutableDictionary *stringIndexes;	// string -> index in strings
+@property (nonatomic, strong) NSMutableData *directory;
+@property (nonatomic, strong) NSMutableData *values;
+@property (nonatomic, assign) NSUInteger fieldCount;
+
+@end
+
+
+#pragma mark - EZFormStateEncoder implementation
+
+@implementation EZFormStateEncoder
+
++ (NSData *)encodedDataWithForm:(EZForm *)form
+{
+    return [self encodedDataWithModelValues:[form modelValues]];
+}
+
++ (NSData *)encodedDataWithModelValues:(NSDictionary *)modelValues
+{
+    EZFormStateEncoder *encoder = [[self alloc] init];
+    [encoder encodeModelValues:modelValues];
+    return encoder.encodedData;
+}
+
+- (void)encodeModelValues:(NSDictionary *)modelValues
+{
+    [modelValues enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, __unused BOOL *stop) {
+	[self encodeModelValue:value forKey:key];
+    }];
+}
+
+- (void)encodeModelValue:(id)value forKey:(NSString *)key
+{
+    NSUInteger valueStart = [self.values length];
+    [self appendValue:value depth:0];
+    
+    EZFormStateAppendVarint(self.directory, [self indexOfString:key]);
+    EZFormStateAppendVarint(self.directory, [self.values length] - valueStart);
+    self.fieldCount++;
+}
+
+- (NSData *)encodedData
+{
+    NSMutableData *data = [NSMutableData dataWithCapacity:[self.values length] + [self.directory length] + 16 * [self.strings count]];
+    [data appendBytes:EZFormStateMagic length:sizeof(EZFormStateMagic)];
+    [data appendBytes:&EZFormStateVersion length:sizeof(EZFormStateVersion)];
+    
+    EZFormStateAppendVarint(data, [self.strings count]);
+    for (NSString *string in self.strings) {
+	NSUInteger length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+	EZFormStateAppendVarint(data, length);
+	NSUInteger dataLength = [data length];
+	[data increaseLengthBy:length];
+	[string getBytes:(uint8_t *)[data mutableBytes] + dataLength maxLength:length usedLength:NULL encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, [string length]) remainingRange:NULL];
+    }
+    
+    EZFormStateAppendVarint(data, self.fieldCount);
+    [data appendData:self.directory];
+    [data appendData:self.values];
+    return data;
+}
+
+
+#pragma mark - Values
+
+- (NSUInteger)indexOfString:(NSString *)string
+{
+    NSNumber *index = self.stringIndexes[string];
+    if (nil == index) {
+	index = @([self.strings count]);
+	NSString *immutableString = [string copy];
+	[self.strings addObject:immutableString];
+	self.stringIndexes[immutableString] = index;
+    }
+    return [index unsignedIntegerValue];
+}
+
+- (void)appendTag:(EZFormStateTag)tag
+{
+    [self.values appendBytes:&tag length:sizeof(tag)];
+}
+
+- (void)appendValue:(id)value depth:(NSUInteger)depth
+{
+    NSMutableData *values = self.values;
+    
+    if (depth > EZFormStateMaximumNestingDepth) {
+	NSException *exception = [NSException exceptionWithName:NSInvalidArgumentException reason:@"Model value nested too deeply to encode" userInfo:nil];
+	@throw exception;
+    }
+    
+    if (nil == value) {
+	[self appendTag:EZFormStateTagNil];
+    }
+    else if ([value isKindOfClass:[NSString class]]) {
+	[self appendTag:EZFormStateTagString];
+	EZFormStateAppendVarint(values, [self indexOfString:value]);
+    }
+    else if ([value isKindOfClass:[NSNumber class]]) {
+	CFNumberRef number = (__bridge CFNumberRef)value;
+	if (value == (__bridge id)kCFBooleanTrue || value == (__bridge id)kCFBooleanFalse) {
+	    [self appendTag:(value == (__bridge id)kCFBooleanTrue ? EZFormStateTagTrue : EZFormStateTagFalse)];
+	}
+	else if (CFNumberIsFloatType(number)) {
+	    [self appendTag:EZFormStateTagDouble];
+	    CFSwappedFloat64 swapped = CFConvertDoubleHostToSwapped([value doubleValue]);
+	    [values appendBytes:&swapped length:sizeof(swapped)];
+	}
+	else if (CFNumberGetType(number) == kCFNumberSInt128Type || (strcmp([value objCType], @encode(unsigned long long)) == 0 && [value unsignedLongLongValue] > INT64_MAX)) {
+	    [self appendTag:EZFormStateTagUnsignedInteger];
+	    EZFormStateAppendVarint(values, [value unsignedLongLongValue]);
+	}
+	else {
+	    int64_t integer = [value longLongValue];
+	    [self appendTag:EZFormStateTagInteger];
+	    EZFormStateAppendVarint(values, ((uint64_t)integer << 1) ^ (uint64_t)(integer >> 63));
+	}
+    }
+    else if ([value isKindOfClass:[NSDate class]]) {
+	[self appendTag:EZFormStateTagDate];
+	CFSwappedFloat64 swapped = CFConvertDoubleHostToSwapped([(NSDate *)value timeIntervalSinceReferenceDate]);
+	[values appendBytes:&swapped length:sizeof(swapped)];
+    }
+    else if ([value isKindOfClass:[NSData class]]) {
+	[self appendTag:EZFormStateTagData];
+	EZFormStateAppendVarint(values, [(NSData *)value length]);
+	[values appendData:value];
+    }
+    else if ([value isKindOfClass:[NSNull class]]) {
+	[self appendTag:EZFormStateTagNull];
+    }
+    else if ([value isKindOfClass:[NSDictionary class]]) {
+	[self appendTag:EZFormStateTagDictionary];
+	EZFormStateAppendVarint(values, [(NSDictionary *)value count]);
+	[(NSDictionary *)value enumerateKeysAndObjectsUsingBlock:^(id key, id object, __unused BOOL *stop) {
+	    [self appendValue:key depth:depth + 1];
+	    [self appendValue:object depth:depth + 1];
+	}];
+    }
+    else if ([value isKindOfClass:[NSArray class]] || [value isKindOfClass:[NSSet class]] || [value isKindOfClass:[NSOrderedSet class]]) {
+	EZFormStateTag tag = ([value isKindOfClass:[NSArray class]] ? EZFormStateTagArray : ([value isKindOfClass:[NSSet class]] ? EZFormStateTagSet : EZFormStateTagOrderedSet));
+	[self appendTag:tag];
+	EZFormStateAppendVarint(values, [(NSArray *)value count]);
+	for (id object in (id<NSFastEnumeration>)value) {
+	    [self appendValue:object depth:depth + 1];
+	}
+    }
+    else {
+	NSException *exception = [NSException exceptionWithName:NSInvalidArgumentException reason:[NSString stringWithFormat:@"Cannot encode model value of class %@", [value class]] userInfo:nil];
+	@throw exception;
+    }
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)init
+{
+    if ((self = [super init])) {
+	self.strings = [NSMutableArray array];
+	self.stringIndexes = [NSMutableDictionary dictionary];
+	self.directory = [NSMutableData data];
+	self.values = [NSMutableData data];
+    }
+    
+    return self;
+}
+
+@end
+
+
+#pragma mark - EZFormStateDecoder class extension
+
+/* Stands for a field value not decoded yet, and for a nil value. */
+static id EZFormStateUndecodedMarker = nil;
+static id EZFormStateNilMarker = nil;
+
+@interface EZFormStateDecoder () {
+    const uint8_t *_bytes;
+    NSUInteger _length;
+    NSUInteger *_stringOffsets;
+    NSUInteger *_stringLengths;
+    NSUInteger _stringCount;
+    NSUInteger *_valueOffsets;
+    NSUInteger *_valueLengths;
+}
+
+@property (nonatomic, strong) NSData *data;		// owns _bytes
+@property (nonatomic, readwrite, copy) NSArray *keys;
+@property (nonatomic, strong) NSDictionary *fieldIndexes;	// key -> index in keys
+@property (nonatomic, strong) NSMutableArray *decodedStrings;
+@property (nonatomic, strong) NSMutableArray *decodedValues;
+
+@end
+
+
+#pragma mark - EZFormStateDecoder implementation
+
+@implementation EZFormStateDecoder
+
++ (void)initialize
+{
+    if (self == [EZFormStateDecoder class]) {
+	EZFormStateUndecodedMarker = [[NSObject alloc] init];
+	EZFormStateNilMarker = [[NSObject alloc] init];
+    }
+}
+
++ (instancetype)decoderWithContentsOfFile:(NSString *)path error:(NSError **)error
+{
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:error];
+    if (nil == data) {
+	return nil;
+    }
+    return [[self alloc] initWithData:data error:error];
+}
+
+- (id)modelValueForKey:(NSString *)key
+{
+    NSNumber *index = self.fieldIndexes[key];
+    if (nil == index) {
+	return nil;
+    }
+    
+    NSUInteger fieldIndex = [index unsignedIntegerValue];
+    id value = self.decodedValues[fieldIndex];
+    if (value == EZFormStateUndecodedMarker) {
+	NSUInteger offset = _valueOffsets[fieldIndex];
+	NSUInteger end = offset + _valueLengths[fieldIndex];
+	id decodedValue = nil;
+	if (![self decodeValue:&decodedValue end:end offset:&offset depth:0]) {
+	    decodedValue = nil;
+	}
+	value = (decodedValue ?: EZFormStateNilMarker);
+	self.decodedValues[fieldIndex] = value;
+    }
+    
+    return (value == EZFormStateNilMarker ? nil : value);
+}
+
+- (NSDictionary *)modelValues
+{
+    NSMutableDictionary *modelValues = [NSMutableDictionary dictionaryWithCapacity:[self.keys count]];
+    for (NSString *key in self.keys) {
+	[modelValues setValue:[self modelValueForKey:key] forKey:key];
+    }
+    return modelValues;
+}
+
+- (void)restoreForm:(EZForm *)form
+{
+    [form beginUpdates];
+    @try {
+	for (NSString *key in self.keys) {
+	    if ([form formFieldForKey:key]) {
+		[form setModelValue:[self modelValueForKey:key] forKey:key];
+	    }
+	}
+    }
+    @finally {
+	[form endUpdates];
+    }
+}
+
+
+#pragma mark - Decoding
+
+- (NSString *)stringAtIndex:(NSUInteger)index
+{
+    if (index >= _stringCount) {
+	return nil;
+    }
+    
+    id string = self.decodedStrings[index];
+    if (string == EZFormStateUndecodedMarker) {
+	string = [[NSString alloc] initWithBytes:_bytes + _stringOffsets[index] length:_stringLengths[index] encoding:NSUTF8StringEncoding];
+	if (nil == string) {
+	    return nil;
+	}
+	self.decodedStrings[index] = string;
+    }
+    return string;
+}
+
+- (BOOL)decodeValue:(__autoreleasing id *)value end:(NSUInteger)end offset:(NSUInteger *)offset depth:(NSUInteger)depth
+{
+    if (*offset >= end || depth > EZFormStateMaximumNestingDepth) {
+	return NO;
+    }
+    
+    const uint8_t *bytes = _bytes;
+    EZFormStateTag tag = bytes[(*offset)++];
+    uint64_t varint;
+    NSUInteger count;
+    
+    switch (tag) {
+	case EZFormStateTagNil:
+	    *value = nil;
+	    return YES;
+	    
+	case EZFormStateTagNull:
+	    *value = [NSNull null];
+	    return YES;
+	    
+	case EZFormStateTagFalse:
+	case EZFormStateTagTrue:
+	    *value = (tag == EZFormStateTagTrue ? @YES : @NO);
+	    return YES;
+	    
+	case EZFormStateTagInteger:
+	    if (!EZFormStateReadVarint(bytes, end, offset, &varint)) return NO;
+	    *value = @((int64_t)(varint >> 1) ^ -(int64_t)(varint & 1));
+	    return YES;
+	    
+	case EZFormStateTagUnsignedInteger:
+	    if (!EZFormStateReadVarint(bytes, end, offset, &varint)) return NO;
+	    *value = @(varint);
+	    return YES;
+	    
+	case EZFormStateTagDouble:
+	case EZFormStateTagDate: {
+	    CFSwappedFloat64 swapped;
+	    if (end - *offset < sizeof(swapped)) return NO;
+	    memcpy(&swapped, bytes + *offset, sizeof(swapped));
+	    *offset += sizeof(swapped);
+	    double doubleValue = CFConvertDoubleSwappedToHost(swapped);
+	    *value = (tag == EZFormStateTagDate ? [NSDate dateWithTimeIntervalSinceReferenceDate:doubleValue] : @(doubleValue));
+	    return YES;
+	}
+	    
+	case EZFormStateTagString:
+	    if (!EZFormStateReadVarint(bytes, end, offset, &varint) || varint >= _stringCount) return NO;
+	    *value = [self stringAtIndex:(NSUInteger)varint];
+	    return (*value != nil);
+	    
+	case EZFormStateTagData:
+	    if (!EZFormStateReadCount(bytes, end, offset, &count) || end - *offset < count) return NO;
+	    *value = [NSData dataWithBytes:bytes + *offset length:count];
+	    *offset += count;
+	    return YES;
+	    
+	case EZFormStateTagArray:
+	case EZFormStateTagSet:
+	case EZFormStateTagOrderedSet:
+	case EZFormStateTagDictionary: {
+	    if (!EZFormStateReadCount(bytes, end, offset, &count)) return NO;
+	    NSUInteger objectCount = (tag == EZFormStateTagDictionary ? 2 * count : count);
+	    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:MIN(objectCount, end - *offset)];
+	    for (NSUInteger i=0; i < objectCount; i++) {
+		id object = nil;
+		if (![self decodeValue:&object end:end offset:offset depth:depth + 1] || nil == object) return NO;
+		[objects addObject:object];
+	    }
+	    
+	    if (tag == EZFormStateTagArray) {
+		*value = [objects copy];
+	    }
+	    else if (tag == EZFormStateTagSet) {
+		*value = [NSSet setWithArray:objects];
+	    }
+	    else if (tag == EZFormStateTagOrderedSet) {
+		*value = [NSOrderedSet orderedSetWithArray:objects];
+	    }
+	    else {
+		NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:count];
+		for (NSUInteger i=0; i < objectCount; i += 2) {
+		    dictionary[objects[i]] = objects[i + 1];
+		}
+		*value = [dictionary copy];
+	    }
+	    return YES;
+	}
+    }
+    
+    return NO;
+}
+
+/* Reads the string table and field directory, without decoding any
+ * string other than the field keys, or any value.
+ */
+- (BOOL)readDirectory
+{
+    const uint8_t *bytes = _bytes;
+    NSUInteger end = _length;
+    NSUInteger offset = EZFormStateHeaderLength;
+    
+    if (!EZFormStateReadCount(bytes, end, &offset, &_stringCount)) return NO;
+    _stringOffsets = calloc(_stringCount ?: 1, sizeof(NSUInteger));
+    _stringLengths = calloc(_stringCount ?: 1, sizeof(NSUInteger));
+    for (NSUInteger i=0; i < _stringCount; i++) {
+	NSUInteger length;
+	if (!EZFormStateReadCount(bytes, end, &offset, &length) || end - offset < length) return NO;
+	_stringOffsets[i] = offset;
+	_stringLengths[i] = length;
+	offset += length;
+    }
+    
+    NSUInteger fieldCount;
+    if (!EZFormStateReadCount(bytes, end, &offset, &fieldCount)) return NO;
+    _valueOffsets = calloc(fieldCount ?: 1, sizeof(NSUInteger));
+    _valueLengths = calloc(fieldCount ?: 1, sizeof(NSUInteger));
+    
+    self.decodedStrings = [NSMutableArray arrayWithCapacity:_stringCount];
+    for (NSUInteger i=0; i < _stringCount; i++) {
+	[self.decodedStrings addObject:EZFormStateUndecodedMarker];
+    }
+    
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:fieldCount];
+    NSMutableDictionary *fieldIndexes = [NSMutableDictionary dictionaryWithCapacity:fieldCount];
+    NSUInteger valueLengthTotal = 0;
+    for (NSUInteger i=0; i < fieldCount; i++) {
+	uint64_t keyIndex;
+	NSUInteger valueLength;
+	if (!EZFormStateReadVarint(bytes, end, &offset, &keyIndex) || keyIndex >= _stringCount) return NO;
+	if (!EZFormStateReadCount(bytes, end, &offset, &valueLength) || valueLength > end - valueLengthTotal) return NO;
+	
+	NSString *key = [self stringAtIndex:(NSUInteger)keyIndex];
+	if (nil == key) return NO;
+	fieldIndexes[key] = @(i);
+	[keys addObject:key];
+	_valueLengths[i] = valueLength;
+	valueLengthTotal += valueLength;
+    }
+    
+    if (end - offset < valueLengthTotal) return NO;
+    for (NSUInteger i=0; i < fieldCount; i++) {
+	_valueOffsets[i] = offset;
+	offset += _valueLengths[i];
+    }
+    
+    self.keys = keys;
+    self.fieldIndexes = fieldIndexes;
+    self.decodedValues = [NSMutableArray arrayWithCapacity:fieldCount];
+    for (NSUInteger i=0; i < fieldCount; i++) {
+	[self.decodedValues addObject:EZFormStateUndecodedMarker];
+    }
+    return YES;
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithData:(NSData *)data error:(NSError **)error
+{
+    if ((self = [super init])) {
+	self.data = data;
+	_bytes = [data bytes];
+	_length = [data length];
+	
+	if (_length < EZFormStateHeaderLength || memcmp(_bytes, EZFormStateMagic, sizeof(EZFormStateMagic)) != 0) {
+	    if (error) *error = [NSError errorWithDomain:EZFormStateDecoderErrorDomain code:EZFormStateDecoderErrorCorruptData userInfo:nil];
+	    return nil;
+	}
+	if (_bytes[4] > EZFormStateVersion) {
+	    if (error) *error = [NSError errorWithDomain:EZFormStateDecoderErrorDomain code:EZFormStateDecoderErrorUnsupportedVersion userInfo:nil];
+	    return nil;
+	}
+	if (![self readDirectory]) {
+	    if (error) *error = [NSError errorWithDomain:EZFormStateDecoderErrorDomain code:EZFormStateDecoderErrorCorruptData userInfo:nil];
+	    return nil;
+	}
+    }
+    
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithData:[EZFormStateEncoder encodedDataWithModelValues:@{}] error:NULL];
+}
+
+- (void)dealloc
+{
+    free(_stringOffsets);
+    free(_stringLengths);
+    free(_valueOffsets);
+    free(_valueLengths);
+}
+
+@end
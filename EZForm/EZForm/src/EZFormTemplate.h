@@ -0,0 +1,110 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+@class EZForm;
+
+
+/** Error domain of EZFormTemplate schema errors.
+ */
+extern NSString * const EZFormTemplateErrorDomain;
+
+typedef NS_ENUM(NSInteger, EZFormTemplateError) {
+    EZFormTemplateErrorInvalidSchema = 1,
+} ;
+
+
+/** A form template parsed once from a schema, for making many forms
+ *  with the same fields.
+ *
+ *  A schema is a dictionary, usually loaded from a JSON or property list
+ *  file, with a "fields" array. Each field is a dictionary with a "key"
+ *  and a "type", one of "text", "boolean", "generic", "radio",
+ *  "multiRadio", "date" or "continuous", plus any of these optional
+ *  entries:
+ *
+ *  - "value": the initial model value.
+ *  - "rules": an EZFormValidationRules spec, such as "required|min:3".
+ *  - "validator": "email" for EZFormEmailAddressValidator.
+ *  - text: "minCharacters", "maxCharacters", "trimWhitespace" and
+ *    "inputFilter" ("email" or "numeric").
+ *  - boolean: "requiredState" ("on" or "off").
+ *  - generic: "notNil".
+ *  - radio and multiRadio: "choices" (an array of keys displayed as
+ *    themselves) or "choiceKeys" and "choiceValues", "requiresSelection",
+ *    "restrictedToChoices" and "unselected"; multiRadio also
+ *    "mutuallyExclusiveChoice".
+ *  - date: "dateFormat" for the field's date formatters.
+ *  - continuous: "minimum", "maximum", "snapsToInteger" and "numberFormat".
+ *
+ *  Everything that can be shared is built once, when the template is
+ *  parsed, and shared by every form made from it: choice stores (copied
+ *  only if a field adds choices, see -[EZFormRadioField setSharedChoiceStore:]),
+ *  compiled validation rules, validator and filter blocks, and date and
+ *  number formatters. Making a form only allocates its fields.
+ */
+@interface EZFormTemplate : NSObject
+
+/** Creates a template from a schema dictionary.
+ *
+ *  @param schema A schema dictionary.
+ *
+ *  @param error On return, an error if the schema is not valid.
+ *
+ *  @returns An EZFormTemplate object, or nil on error.
+ */
++ (instancetype)templateWithSchema:(NSDictionary *)schema error:(NSError **)error;
+
+/** Creates a template from JSON or property list schema data.
+ *
+ *  @param data JSON, XML property list or binary property list data.
+ *
+ *  @param error On return, an error if the data is not a valid schema.
+ *
+ *  @returns An EZFormTemplate object, or nil on error.
+ */
++ (instancetype)templateWithData:(NSData *)data error:(NSError **)error;
+
+/** Initialises a template from a schema dictionary.
+ *
+ *  @param schema A schema dictionary.
+ *
+ *  @param error On return, an error if the schema is not valid.
+ *
+ *  @returns Initialised EZFormTemplate object, or nil on error.
+ */
+- (instancetype)initWithSchema:(NSDictionary *)schema error:(NSError **)error NS_DESIGNATED_INITIALIZER;
+
+/** The keys of the template's fields, in schema order.
+ */
+@property (nonatomic, readonly, copy) NSArray *fieldKeys;
+
+/** Makes a new form with the template's fields, in schema order.
+ *
+ *  @returns A new EZForm object.
+ */
+- (EZForm *)instantiateForm;
+
+@end
@@ -0,0 +1,433 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormTemplate.h"
+#import "EZForm.h"
+
+NSString * const EZFormTemplateErrorDomain = @"EZFormTemplateErrorDomain";
+
+typedef void (^EZFormTemplateFieldConfiguration)(id formField);
+
+
+#pragma mark - EZFormTemplateField
+
+/* One parsed field of a template: everything needed to make the field,
+ * with shared objects captured by the configuration blocks.
+ */
+@interface EZFormTemplateField : NSObject
+
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic, strong) Class fieldClass;
+@property (nonatomic, strong) id initialValue;
+@property (nonatomic, strong) NSMutableArray *configurations;	// EZFormTemplateFieldConfiguration blocks
+
+@end
+
+@implementation EZFormTemplateField
+@end
+
+
+#pragma mark - EZFormTemplate class extension
+
+@interface EZFormTemplate ()
+
+@property (nonatomic, copy) NSArray *templateFields;
+@property (nonatomic, readwrite, copy) NSArray *fieldKeys;
+
+@end
+
+
+#pragma mark - EZFormTemplate implementation
+
+@implementation EZFormTemplate
+
++ (instancetype)templateWithSchema:(NSDictionary *)schema error:(NSError **)error
+{
+    return [[self alloc] initWithSchema:schema error:error];
+}
+
++ (instancetype)templateWithData:(NSData *)data error:(NSError **)error
+{
+    id schema = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:NULL];
+    if (nil == schema) {
+	schema = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+	if (nil == schema) {
+	    return nil;
+	}
+    }
+    
+    if (![schema isKindOfClass:[NSDictionary class]]) {
+	if (error) *error = [self schemaErrorWithReason:@"Schema is not a dictionary"];
+	return nil;
+    }
+    return [self templateWithSchema:schema error:error];
+}
+
+- (EZForm *)instantiateForm
+{
+    EZForm *form = [[EZForm alloc] init];
+    for (EZFormTemplateField *templateField in self.templateFields) {
+	EZFormField *formField = [[templateField.fieldClass alloc] initWithKey:templateField.key];
+	for (EZFormTemplateFieldConfiguration configuration in templateField.configurations) {
+	    configuration(formField);
+	}
+	if (templateField.initialValue) {
+	    formField.modelValue = templateField.initialValue;
+	}
+	[form addFormField:formField];
+    }
+    return form;
+}
+
+
+#pragma mark - Schema parsing
+
++ (NSError *)schemaErrorWithReason:(NSString *)reason
+{
+    return [NSError errorWithDomain:EZFormTemplateErrorDomain code:EZFormTemplateErrorInvalidSchema userInfo:@{NSLocalizedDescriptionKey: reason}];
+}
+
++ (NSDictionary *)fieldClassesByType
+{
+    static NSDictionary *fieldClassesByType = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	fieldClassesByType = @{
+	    @"text": [EZFormTextField class],
+	    @"boolean": [EZFormBooleanField class],
+	    @"generic": [EZFormGenericField class],
+	    @"radio": [EZFormRadioField class],
+	    @"multiRadio": [EZFormMultiRadioFormField class],
+	    @"date": [EZFormDateField class],
+	    @"continuous": [EZFormContinuousField class],
+	};
+    });
+    return fieldClassesByType;
+}
+
+/* Returns the entry of a field schema, or nil if it is missing. Sets
+ * *error and returns nil if it is not of class cls.
+ */
+- (id)entry:(NSString *)name ofField:(NSDictionary *)fieldSchema class:(Class)cls error:(NSError **)error
+{
+    id value = fieldSchema[name];
+    if (value && ![value isKindOfClass:cls]) {
+	*error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" entry \"%@\" should be a %@", fieldSchema[@"key"], name, NSStringFromClass(cls)]];
+	return nil;
+    }
+    return value;
+}
+
+- (EZFormTemplateField *)templateFieldWithSchema:(NSDictionary *)fieldSchema error:(NSError **)error
+{
+    if (![fieldSchema isKindOfClass:[NSDictionary class]]) {
+	*error = [[self class] schemaErrorWithReason:@"Field is not a dictionary"];
+	return nil;
+    }
+    
+    NSString *key = [self entry:@"key" ofField:fieldSchema class:[NSString class] error:error];
+    NSString *type = [self entry:@"type" ofField:fieldSchema class:[NSString class] error:error];
+    Class fieldClass = (type ? [[self class] fieldClassesByType][type] : Nil);
+    if (nil == key || nil == fieldClass) {
+	if (nil == *error) *error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" needs a key and a known type", key]];
+	return nil;
+    }
+    
+    EZFormTemplateField *templateField = [[EZFormTemplateField alloc] init];
+    templateField.key = key;
+    templateField.fieldClass = fieldClass;
+    templateField.initialValue = fieldSchema[@"value"];
+    templateField.configurations = [NSMutableArray array];
+    NSMutableArray *configurations = templateField.configurations;
+    
+    // Validation shared by all field types
+    NSString *rulesSpec = [self entry:@"rules" ofField:fieldSchema class:[NSString class] error:error];
+    if (rulesSpec) {
+	NSError *rulesError = nil;
+	EZFormValidationRules *rules = [EZFormValidationRules validationRulesWithSpec:rulesSpec error:&rulesError];
+	if (nil == rules) {
+	    *error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" rules: %@", key, [rulesError localizedDescription]]];
+	    return nil;
+	}
+	[configurations addObject:^(EZFormField *formField) {
+	    formField.validationRules = rules;
+	}];
+    }
+    
+    NSString *validatorName = [self entry:@"validator" ofField:fieldSchema class:[NSString class] error:error];
+    if (validatorName) {
+	if (![validatorName isEqualToString:@"email"]) {
+	    *error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" has unknown validator \"%@\"", key, validatorName]];
+	    return nil;
+	}
+	[configurations addObject:^(EZFormField *formField) {
+	    [formField addValidator:EZFormEmailAddressValidator];
+	}];
+    }
+    
+    BOOL configured = YES;
+    if ([fieldClass isSubclassOfClass:[EZFormDateField class]]) {
+	configured = [self addDateConfigurations:configurations schema:fieldSchema error:error];
+    }
+    if (configured && [fieldClass isSubclassOfClass:[EZFormTextField class]]) {
+	configured = [self addTextConfigurations:configurations schema:fieldSchema error:error];
+    }
+    if (configured && [fieldClass isSubclassOfClass:[EZFormRadioField class]]) {
+	configured = [self addRadioConfigurations:configurations schema:fieldSchema error:error];
+    }
+    if (configured && [fieldClass isSubclassOfClass:[EZFormBooleanField class]]) {
+	configured = [self addBooleanConfigurations:configurations schema:fieldSchema error:error];
+    }
+    if (configured && [fieldClass isSubclassOfClass:[EZFormGenericField class]]) {
+	NSNumber *notNil = [self entry:@"notNil" ofField:fieldSchema class:[NSNumber class] error:error];
+	if (notNil) {
+	    BOOL validationNotNil = [notNil boolValue];
+	    [configurations addObject:^(EZFormGenericField *formField) {
+		formField.validationNotNil = validationNotNil;
+	    }];
+	}
+    }
+    if (configured && [fieldClass isSubclassOfClass:[EZFormContinuousField class]]) {
+	configured = [self addContinuousConfigurations:configurations schema:fieldSchema error:error];
+    }
+    
+    if (!configured || *error) {
+	return nil;
+    }
+    return templateField;
+}
+
+- (BOOL)addTextConfigurations:(NSMutableArray *)configurations schema:(NSDictionary *)fieldSchema error:(NSError **)error
+{
+    NSNumber *minCharacters = [self entry:@"minCharacters" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSNumber *maxCharacters = [self entry:@"maxCharacters" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSNumber *trimWhitespace = [self entry:@"trimWhitespace" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSString *inputFilter = [self entry:@"inputFilter" ofField:fieldSchema class:[NSString class] error:error];
+    if (*error) return NO;
+    
+    if (minCharacters) {
+	NSUInteger validationMinCharacters = [minCharacters unsignedIntegerValue];
+	[configurations addObject:^(EZFormTextField *formField) {
+	    formField.validationMinCharacters = validationMinCharacters;
+	}];
+    }
+    if (maxCharacters) {
+	NSUInteger inputMaxCharacters = [maxCharacters unsignedIntegerValue];
+	[configurations addObject:^(EZFormTextField *formField) {
+	    formField.inputMaxCharacters = inputMaxCharacters;
+	}];
+    }
+    if (trimWhitespace) {
+	BOOL trim = [trimWhitespace boolValue];
+	[configurations addObject:^(EZFormTextField *formField) {
+	    formField.trimWhitespace = trim;
+	}];
+    }
+    if ([inputFilter isEqualToString:@"email"]) {
+	[configurations addObject:^(EZFormTextField *formField) {
+	    [formField addInputFilter:EZFormEmailAddressInputFilter];
+	}];
+    }
+    else if ([inputFilter isEqualToString:@"numeric"]) {
+	[configurations addObject:^(EZFormTextField *formField) {
+	    [formField addInputDeltaFilter:EZFormNumericInputDeltaFilter];
+	}];
+    }
+    else if (inputFilter) {
+	*error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" has unknown input filter \"%@\"", fieldSchema[@"key"], inputFilter]];
+	return NO;
+    }
+    return YES;
+}
+
+- (BOOL)addDateConfigurations:(NSMutableArray *)configurations schema:(NSDictionary *)fieldSchema error:(NSError **)error
+{
+    NSString *dateFormat = [self entry:@"dateFormat" ofField:fieldSchema class:[NSString class] error:error];
+    if (*error) return NO;
+    
+    if (dateFormat) {
+	NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+	[dateFormatter setDateFormat:dateFormat];
+	[configurations addObject:^(EZFormDateField *formField) {
+	    formField.inDateFormatter = dateFormatter;
+	    formField.outDateFormatter = dateFormatter;
+	}];
+    }
+    return YES;
+}
+
+- (BOOL)addRadioConfigurations:(NSMutableArray *)configurations schema:(NSDictionary *)fieldSchema error:(NSError **)error
+{
+    NSArray *choices = [self entry:@"choices" ofField:fieldSchema class:[NSArray class] error:error];
+    NSArray *choiceKeys = [self entry:@"choiceKeys" ofField:fieldSchema class:[NSArray class] error:error];
+    NSArray *choiceValues = [self entry:@"choiceValues" ofField:fieldSchema class:[NSArray class] error:error];
+    NSNumber *requiresSelection = [self entry:@"requiresSelection" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSNumber *restrictedToChoices = [self entry:@"restrictedToChoices" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSString *unselected = [self entry:@"unselected" ofField:fieldSchema class:[NSString class] error:error];
+    NSString *mutuallyExclusiveChoice = [self entry:@"mutuallyExclusiveChoice" ofField:fieldSchema class:[NSString class] error:error];
+    if (*error) return NO;
+    
+    if (choices) {
+	choiceKeys = choices;
+	choiceValues = choices;
+    }
+    if ([choiceKeys count] != [choiceValues count]) {
+	*error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" needs as many choice values as keys", fieldSchema[@"key"]]];
+	return NO;
+    }
+    
+    if (choiceKeys) {
+	EZFormChoiceStore *choiceStore = [[EZFormChoiceStore alloc] initWithKeys:choiceKeys values:choiceValues];
+	[configurations addObject:^(EZFormRadioField *formField) {
+	    [formField setSharedChoiceStore:choiceStore];
+	}];
+    }
+    if (requiresSelection) {
+	BOOL validationRequiresSelection = [requiresSelection boolValue];
+	[configurations addObject:^(EZFormRadioField *formField) {
+	    formField.validationRequiresSelection = validationRequiresSelection;
+	}];
+    }
+    if (restrictedToChoices) {
+	BOOL validationRestrictedToChoiceValues = [restrictedToChoices boolValue];
+	[configurations addObject:^(EZFormRadioField *formField) {
+	    formField.validationRestrictedToChoiceValues = validationRestrictedToChoiceValues;
+	}];
+    }
+    if (unselected) {
+	[configurations addObject:^(EZFormRadioField *formField) {
+	    formField.unselected = unselected;
+	}];
+    }
+    if (mutuallyExclusiveChoice) {
+	[configurations addObject:^(EZFormMultiRadioFormField *formField) {
+	    if ([formField isKindOfClass:[EZFormMultiRadioFormField class]]) {
+		formField.mutuallyExclusiveChoice = mutuallyExclusiveChoice;
+	    }
+	}];
+    }
+    return YES;
+}
+
+- (BOOL)addBooleanConfigurations:(NSMutableArray *)configurations schema:(NSDictionary *)fieldSchema error:(NSError **)error
+{
+    NSString *requiredState = [self entry:@"requiredState" ofField:fieldSchema class:[NSString class] error:error];
+    if (*error) return NO;
+    
+    if (requiredState) {
+	EZFormBooleanFieldState validationStates;
+	if ([requiredState isEqualToString:@"on"]) {
+	    validationStates = EZFormBooleanFieldStateOn;
+	}
+	else if ([requiredState isEqualToString:@"off"]) {
+	    validationStates = EZFormBooleanFieldStateOff;
+	}
+	else {
+	    *error = [[self class] schemaErrorWithReason:[NSString stringWithFormat:@"Field \"%@\" has unknown required state \"%@\"", fieldSchema[@"key"], requiredState]];
+	    return NO;
+	}
+	[configurations addObject:^(EZFormBooleanField *formField) {
+	    formField.validationStates = validationStates;
+	}];
+    }
+    return YES;
+}
+
+- (BOOL)addContinuousConfigurations:(NSMutableArray *)configurations schema:(NSDictionary *)fieldSchema error:(NSError **)error
+{
+    NSNumber *minimum = [self entry:@"minimum" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSNumber *maximum = [self entry:@"maximum" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSNumber *snapsToInteger = [self entry:@"snapsToInteger" ofField:fieldSchema class:[NSNumber class] error:error];
+    NSString *numberFormat = [self entry:@"numberFormat" ofField:fieldSchema class:[NSString class] error:error];
+    if (*error) return NO;
+    
+    if (minimum) {
+	NSInteger minimumValue = [minimum integerValue];
+	[configurations addObject:^(EZFormContinuousField *formField) {
+	    formField.minimumValue = minimumValue;
+	}];
+    }
+    if (maximum) {
+	NSInteger maximumValue = [maximum integerValue];
+	[configurations addObject:^(EZFormContinuousField *formField) {
+	    formField.maximumValue = maximumValue;
+	}];
+    }
+    if (snapsToInteger) {
+	BOOL snaps = [snapsToInteger boolValue];
+	[configurations addObject:^(EZFormContinuousField *formField) {
+	    formField.snapsToInteger = snaps;
+	}];
+    }
+    if (numberFormat) {
+	NSNumberFormatter *numberFormatter = [[NSNumberFormatter alloc] init];
+	[numberFormatter setPositiveFormat:numberFormat];
+	[configurations addObject:^(EZFormContinuousField *formField) {
+	    formField.valueFormatter = numberFormatter;
+	}];
+    }
+    return YES;
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithSchema:(NSDictionary *)schema error:(NSError **)error
+{
+    if ((self = [super init])) {
+	NSArray *fieldSchemas = schema[@"fields"];
+	if (![fieldSchemas isKindOfClass:[NSArray class]]) {
+	    if (error) *error = [[self class] schemaErrorWithReason:@"Schema needs a \"fields\" array"];
+	    return nil;
+	}
+	
+	NSError *schemaError = nil;
+	NSMutableArray *templateFields = [NSMutableArray arrayWithCapacity:[fieldSchemas count]];
+	NSMutableArray *fieldKeys = [NSMutableArray arrayWithCapacity:[fieldSchemas count]];
+	for (NSUInteger i=0; i < [fieldSchemas count] && nil == schemaError; i++) {
+	    EZFormTemplateField *templateField = [self templateFieldWithSchema:fieldSchemas[i] error:&schemaError];
+	    if (templateField) {
+		[templateFields addObject:templateField];
+		[fieldKeys addObject:templateField.key];
+	    }
+	}
+	
+	if (schemaError) {
+	    if (error) *error = schemaError;
+	    return nil;
+	}
+	
+	self.templateFields = templateFields;
+	self.fieldKeys = fieldKeys;
+    }
+    
+    return self;
+}
+
+- (instancetype)init
+{
+    return [self initWithSchema:@{@"fields": @[]} error:NULL];
+}
+
+@end
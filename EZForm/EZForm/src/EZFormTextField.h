@@ -34,6 +34,16 @@ typedef NS_ENUM(NSInteger, EZFormTextFieldInvalidIndicatorPosition) {
 
 typedef BOOL (*TEXTFIELDFILTER)(id);
 
+/** A block that decides whether an edit to the text is allowed, given
+ *  only the change.
+ *
+ *  @param text The text before the edit. It has already passed all
+ *  input filters.
+ *  @param range The range of characters in text being replaced.
+ *  @param replacement The string replacing that range.
+ */
+typedef BOOL (^EZFormTextFieldDeltaFilter)(NSString *text, NSRange range, NSString *replacement);
+
 /** A form field to handle text input.
  *
  *  EZFormTextField instances can be optionally wired up to views of type:
@@ -118,10 +128,31 @@ typedef BOOL (*TEXTFIELDFILTER)(id);
  */
 - (void)addInputFilter:(BOOL(^)(id input))inputFilter;
 
+/** Add an input delta filter.
+ *
+ *  Like a text filter added by addInputFilter:, but instead of the
+ *  whole resulting string the filter receives the text before the edit,
+ *  the range being replaced and the replacement string. Since the text
+ *  before the edit has already been allowed, most filters only need to
+ *  inspect the replacement string, which keeps each keystroke cheap in
+ *  very long texts.
+ *
+ *  Delta filters are called, in the order they were added, before any
+ *  other text filters. The resulting string is only built when at least
+ *  one text filter added by addInputFilter: or setInputFilterFunction:
+ *  needs it.
+ *
+ *  Also see removeInputFilters.
+ *
+ *  @param deltaFilter A block that returns YES to allow the edit, or
+ *  NO to disallow it.
+ */
+- (void)addInputDeltaFilter:(EZFormTextFieldDeltaFilter)deltaFilter;
+
 /** Removes all block text filters
  *
- *  All block text filters added by addInputFilter: will be
- *  removed.
+ *  All block text filters added by addInputFilter: or
+ *  addInputDeltaFilter: will be removed.
  *
  *  This method does not effect any function text filter
  *  added by setInputFilterFunction:.
@@ -24,6 +24,7 @@
 
 #import "EZFormTextField.h"
 #import "EZForm+Private.h"
+#import "EZFormField+Private.h"
 
 
 @interface UIView (EZFormTextFieldExtension)
@@ -35,10 +36,12 @@
 
 @interface EZFormTextField () {
     TEXTFIELDFILTER inputFilterFn;
+    NSString *trimmedValue;	// cached trimmed internalValue, nil if not yet trimmed
 }
 
 @property (nonatomic, copy) NSString *internalValue;
 @property (nonatomic, strong) NSMutableArray *inputFilterBlocks;
+@property (nonatomic, strong) NSMutableArray *inputDeltaFilterBlocks;
 @property (nonatomic, strong) UIView *userControl;
 
 @end
@@ -56,9 +59,15 @@
     [self.inputFilterBlocks addObject:[inputFilter copy]];
 }
 
+- (void)addInputDeltaFilter:(EZFormTextFieldDeltaFilter)deltaFilter
+{
+    [self.inputDeltaFilterBlocks addObject:[deltaFilter copy]];
+}
+
 - (void)removeInputFilters
 {
     [self.inputFilterBlocks removeAllObjects];
+    [self.inputDeltaFilterBlocks removeAllObjects];
 }
 
 - (void)setInputFilterFunction:(TEXTFIELDFILTER)filterFn
@@ -267,6 +276,11 @@
 - (void)updateValidityIndicators
 {
     if (self.invalidIndicatorView) {
+	__strong EZForm *form = self.form;
+	if ([form deferValidityIndicatorUpdateForFormField:self]) {
+	    return;
+	}
+	
 	// ** Currently only supported by UITextField views
 	
 	if ([self.userControl isKindOfClass:[UITextField class]]) {
@@ -296,15 +310,28 @@
 
 - (BOOL)formFieldWithText:(NSString *)text shouldChangeCharactersInRange:(NSRange)range replacementString:(NSString *)string
 {
-    NSString *resultingString = [text stringByReplacingCharactersInRange:range withString:string];
+    // Check the length arithmetically. The length of the untrimmed string
+    // also bounds the trimmed one.
+    NSUInteger resultingLength = [text length] - range.length + [string length];
+    if (self.inputMaxCharacters > 0 && resultingLength > self.inputMaxCharacters) {
+	return NO;
+    }
     
-    if (self.trimWhitespace) {
-	if (self.inputMaxCharacters > 0 && [resultingString length] > self.inputMaxCharacters) {
-	    // Prevent non-trimmed string from exceeding max chars
+    for (EZFormTextFieldDeltaFilter deltaFilter in self.inputDeltaFilterBlocks) {
+	if (!deltaFilter(text, range, string)) {
 	    return NO;
 	}
-	
-	resultingString = [resultingString stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    }
+    
+    if ([self.inputFilterBlocks count] == 0 && NULL == inputFilterFn) {
+	// No filter needs the resulting string
+	return YES;
+    }
+    
+    NSString *resultingString = [text stringByReplacingCharactersInRange:range withString:string];
+    
+    if (self.trimWhitespace) {
+	resultingString = [self trimmedStringFromString:resultingString];
     }
     
     BOOL result = [self isInputValid:resultingString];
@@ -312,6 +339,22 @@
 }
 
 
+#pragma mark - Validation rules
+
+- (void)setValidationMinCharacters:(NSUInteger)validationMinCharacters
+{
+    _validationMinCharacters = validationMinCharacters;
+    [self setNeedsValidation];
+}
+
+- (void)setTrimWhitespace:(BOOL)trimWhitespace
+{
+    _trimWhitespace = trimWhitespace;
+    trimmedValue = nil;
+    [self fieldValueDidChange];
+}
+
+
 #pragma mark - EZFormFieldConcrete methods
 
 - (BOOL)typeSpecificValidation
@@ -390,8 +433,11 @@
 - (id)actualFieldValue
 {
     NSString *value = self.internalValue;
-    if (self.trimWhitespace) {
-	value = [value stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    if (self.trimWhitespace && value) {
+	if (nil == trimmedValue) {
+	    trimmedValue = [self trimmedStringFromString:value];
+	}
+	value = trimmedValue;
     }
 
     return value;
@@ -399,12 +445,45 @@
 
 - (void)setActualFieldValue:(id)value
 {
-    if (value) {
+    if ([value isKindOfClass:[NSString class]]) {
+	// A copy of an immutable string is the same string; no reformatting needed
+	self.internalValue = value;
+    }
+    else if (value) {
 	self.internalValue = [NSString stringWithFormat:@"%@", value];
     }
     else {
 	self.internalValue = value;
     }
+    trimmedValue = nil;
+}
+
+/* Trims whitespace and newlines off both ends of string by scanning
+ * inwards from each end. Returns string itself when there is nothing
+ * to trim, so long values are not copied on every read.
+ */
+- (NSString *)trimmedStringFromString:(NSString *)string
+{
+    NSCharacterSet *whitespaceCharset = [NSCharacterSet whitespaceAndNewlineCharacterSet];
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cfString);
+    CFStringInlineBuffer buffer;
+    
+    CFIndex start = 0;
+    CFStringInitInlineBuffer(cfString, &buffer, CFRangeMake(0, length));
+    while (start < length && [whitespaceCharset characterIsMember:CFStringGetCharacterFromInlineBuffer(&buffer, start)]) {
+	start++;
+    }
+    
+    CFIndex end = length;
+    while (end > start && [whitespaceCharset characterIsMember:CFStringGetCharacterFromInlineBuffer(&buffer, end - 1)]) {
+	end--;
+    }
+    
+    if (start == 0 && end == length) {
+	return string;
+    }
+    return [string substringWithRange:NSMakeRange((NSUInteger)start, (NSUInteger)(end - start))];
 }
 
 - (void)becomeFirstResponder
@@ -461,6 +540,7 @@
 	_trimWhitespace = YES;
 	_invalidIndicatorPosition = EZFormTextFieldInvalidIndicatorPositionRight;
 	_inputFilterBlocks = [[NSMutableArray alloc] init];
+	_inputDeltaFilterBlocks = [[NSMutableArray alloc] init];
     }
     
     return self;
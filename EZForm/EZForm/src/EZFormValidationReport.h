@@ -0,0 +1,117 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+/** The validation step a field value failed.
+ */
+typedef NS_ENUM(NSInteger, EZFormValidationFailure) {
+    EZFormValidationFailureNone = 0,		// the value is valid
+    EZFormValidationFailureValidator,		// a block added with addValidator:
+    EZFormValidationFailureValidationFunction,	// the function set with setValidationFunction:
+    EZFormValidationFailureValidationRules,	// a rule of validationRules
+    EZFormValidationFailureTypeSpecific,	// validation built into the field class
+    EZFormValidationFailureAsyncValidator,	// an asynchronous validator
+    EZFormValidationFailurePending,		// asynchronous validation has not finished
+};
+
+
+/** The result of validating one form field.
+ *
+ *  Reports are immutable. A field caches its report until its value or
+ *  validation rules change, so reading a report does not run any
+ *  validators. See -[EZFormField validationReport].
+ */
+@interface EZFormFieldValidationReport : NSObject
+
+/** The key of the field.
+ */
+@property (nonatomic, readonly, copy) NSString *key;
+
+/** The valueVersion of the field when it was validated.
+ */
+@property (nonatomic, readonly) NSUInteger valueVersion;
+
+/** Whether the field value passed validation.
+ */
+@property (nonatomic, getter=isValid, readonly) BOOL valid;
+
+/** The validation step the value failed, or EZFormValidationFailureNone.
+ */
+@property (nonatomic, readonly) EZFormValidationFailure failure;
+
+/** The index, in the order they were added, of the validator block that
+ *  failed. NSNotFound unless failure is EZFormValidationFailureValidator.
+ */
+@property (nonatomic, readonly) NSUInteger failedValidatorIndex;
+
+/** The validation rule that failed, as written in its spec (for example
+ *  @"min:3"). nil unless failure is EZFormValidationFailureValidationRules.
+ */
+@property (nonatomic, readonly, copy) NSString *failedRule;
+
+/** A short description of the failure, for logging and debugging.
+ *
+ *  Not localized; build messages shown to users from failure,
+ *  failedValidatorIndex and failedRule instead. nil if the value is valid.
+ */
+@property (nonatomic, readonly, copy) NSString *failureReason;
+
+@end
+
+
+/** The result of validating a whole form.
+ *
+ *  Reports are immutable. A form caches its report until a field needs
+ *  revalidating or fields are added or removed. See
+ *  -[EZForm validationReport].
+ */
+@interface EZFormValidationReport : NSObject
+
+/** Whether every field of the form passed validation.
+ */
+@property (nonatomic, getter=isValid, readonly) BOOL valid;
+
+/** The keys of the fields that did not pass validation, in the order the
+ *  fields were added to the form.
+ */
+@property (nonatomic, readonly, copy) NSArray *invalidFieldKeys;
+
+/** The reports of the fields that did not pass validation, in the same
+ *  order as invalidFieldKeys.
+ */
+@property (nonatomic, readonly, copy) NSArray *failedFieldReports;
+
+/** Returns the report of the field with a key, if it did not pass
+ *  validation.
+ *
+ *  @param key A field key.
+ *
+ *  @returns The report of the field, or nil if the field is valid or
+ *  there is no field with the key.
+ */
+- (EZFormFieldValidationReport *)failedReportForFieldKey:(NSString *)key;
+
+@end
@@ -0,0 +1,144 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormValidationReport.h"
+
+
+#pragma mark - EZFormFieldValidationReport
+
+@interface EZFormFieldValidationReport ()
+
+@property (nonatomic, readwrite, copy) NSString *key;
+@property (nonatomic, readwrite, assign) NSUInteger valueVersion;
+@property (nonatomic, readwrite, assign) EZFormValidationFailure failure;
+@property (nonatomic, readwrite, assign) NSUInteger failedValidatorIndex;
+@property (nonatomic, readwrite, copy) NSString *failedRule;
+@property (nonatomic, readwrite, copy) NSString *failedFieldClassName;
+
+@end
+
+@implementation EZFormFieldValidationReport
+
+- (BOOL)isValid
+{
+    return (EZFormValidationFailureNone == self.failure);
+}
+
+- (NSString *)failureReason
+{
+    switch (self.failure) {
+	case EZFormValidationFailureNone:
+	    return nil;
+	case EZFormValidationFailureValidator:
+	    return [NSString stringWithFormat:@"Validator %lu failed", (unsigned long)self.failedValidatorIndex];
+	case EZFormValidationFailureValidationFunction:
+	    return @"Validation function failed";
+	case EZFormValidationFailureValidationRules:
+	    return [NSString stringWithFormat:@"Validation rule \"%@\" failed", self.failedRule];
+	case EZFormValidationFailureTypeSpecific:
+	    return [NSString stringWithFormat:@"%@ validation failed", self.failedFieldClassName];
+	case EZFormValidationFailureAsyncValidator:
+	    return @"Asynchronous validation failed";
+	case EZFormValidationFailurePending:
+	    return @"Asynchronous validation pending";
+    }
+    return nil;
+}
+
+- (instancetype)initWithKey:(NSString *)key valueVersion:(NSUInteger)valueVersion failure:(EZFormValidationFailure)failure failedValidatorIndex:(NSUInteger)failedValidatorIndex failedRule:(NSString *)failedRule fieldClass:(Class)fieldClass
+{
+    if ((self = [super init])) {
+	_key = [key copy];
+	_valueVersion = valueVersion;
+	_failure = failure;
+	_failedValidatorIndex = (EZFormValidationFailureValidator == failure ? failedValidatorIndex : NSNotFound);
+	_failedRule = (EZFormValidationFailureValidationRules == failure ? [failedRule copy] : nil);
+	_failedFieldClassName = NSStringFromClass(fieldClass);
+    }
+    
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p key=%@ valid=%@%@%@>", [self class], self, self.key, (self.valid ? @"YES" : @"NO"), (self.failureReason ? @" reason=" : @""), (self.failureReason ?: @"")];
+}
+
+@end
+
+
+#pragma mark - EZFormValidationReport
+
+@interface EZFormValidationReport ()
+
+@property (nonatomic, readwrite, copy) NSArray *invalidFieldKeys;
+@property (nonatomic, readwrite, copy) NSArray *failedFieldReports;
+@property (nonatomic, copy) NSDictionary *failedFieldReportsByKey;
+
+@end
+
+@implementation EZFormValidationReport
+
+- (BOOL)isValid
+{
+    return ([self.failedFieldReports count] == 0);
+}
+
+- (EZFormFieldValidationReport *)failedReportForFieldKey:(NSString *)key
+{
+    if (nil == key) {
+	return nil;
+    }
+    return self.failedFieldReportsByKey[key];
+}
+
+- (instancetype)initWithFailedFieldReports:(NSArray *)failedFieldReports
+{
+    if ((self = [super init])) {
+	NSMutableArray *invalidFieldKeys = [NSMutableArray arrayWithCapacity:[failedFieldReports count]];
+	NSMutableDictionary *failedFieldReportsByKey = [NSMutableDictionary dictionaryWithCapacity:[failedFieldReports count]];
+	for (EZFormFieldValidationReport *fieldReport in failedFieldReports) {
+	    NSString *key = fieldReport.key;
+	    if (key) {
+		[invalidFieldKeys addObject:key];
+		if (nil == failedFieldReportsByKey[key]) {
+		    failedFieldReportsByKey[key] = fieldReport;
+		}
+	    }
+	}
+	
+	_failedFieldReports = [failedFieldReports copy];
+	_invalidFieldKeys = invalidFieldKeys;
+	_failedFieldReportsByKey = failedFieldReportsByKey;
+    }
+    
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p valid=%@ invalidFieldKeys=%@>", [self class], self, (self.valid ? @"YES" : @"NO"), self.invalidFieldKeys];
+}
+
+@end
@@ -0,0 +1,120 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+/** Error domain of EZFormValidationRules spec errors.
+ */
+extern NSString * const EZFormValidationRulesErrorDomain;
+
+typedef NS_ENUM(NSInteger, EZFormValidationRulesError) {
+    EZFormValidationRulesErrorInvalidSpec = 1,
+} ;
+
+/** An immutable, compiled set of declarative validation rules.
+ *
+ *  Rules are described by a spec string of rules separated by "|", for
+ *  example:
+ *
+ *	@"required|min:3|max:64|email"
+ *	@"numeric:0..150"
+ *
+ *  Supported rules:
+ *
+ *  - `required` The value must not be nil, NSNull, an empty string or
+ *    an empty collection.
+ *  - `min:N` Strings must be at least N characters long, collections must
+ *    hold at least N objects and numbers must be at least N.
+ *  - `max:N` Strings must be at most N characters long, collections must
+ *    hold at most N objects and numbers must be at most N.
+ *  - `email` The value must be an email address, as checked by
+ *    EZFormValidateEmailFormat().
+ *  - `numeric` The value must be a number or a string of decimal digits.
+ *    An optional range `numeric:MIN..MAX` limits the value; either bound
+ *    may be left out, as in `numeric:18..`.
+ *
+ *  Unless `required` is part of the spec, an empty value passes all
+ *  other rules.
+ *
+ *  A spec is parsed only once. validationRulesWithSpec: returns the same
+ *  compiled instance for the same spec for as long as any field uses it,
+ *  so any number of fields can share one set of rules.
+ *
+ *  Assign rules to a field with -[EZFormField setValidationRules:].
+ */
+@interface EZFormValidationRules : NSObject
+
+/** The spec the rules were compiled from.
+ */
+@property (nonatomic, readonly, copy) NSString *spec;
+
+/** Returns compiled rules for a spec.
+ *
+ *  Raises an NSInvalidArgumentException if the spec contains an
+ *  unknown or malformed rule.
+ *
+ *  @param spec A rule spec, such as @"required|min:3".
+ *
+ *  @returns A shared EZFormValidationRules instance.
+ */
++ (instancetype)validationRulesWithSpec:(NSString *)spec;
+
+/** Returns compiled rules for a spec, or an error if the spec is invalid.
+ *
+ *  Use this for specs that are not part of the code, such as those read
+ *  from a form template.
+ *
+ *  @param spec A rule spec, such as @"required|min:3".
+ *
+ *  @param error If the spec contains an unknown or malformed rule and
+ *  error is not NULL, set to an EZFormValidationRulesErrorDomain error
+ *  describing it.
+ *
+ *  @returns A shared EZFormValidationRules instance, or nil if the spec
+ *  is invalid.
+ */
++ (instancetype)validationRulesWithSpec:(NSString *)spec error:(NSError **)error;
+
+/** Returns a boolean indicating whether a value passes all rules.
+ *
+ *  @param value The value to validate.
+ *
+ *  @returns YES if the value is valid, NO otherwise.
+ */
+- (BOOL)validateValue:(id)value;
+
+/** Returns a boolean indicating whether a value passes all rules, and
+ *  which rule it failed.
+ *
+ *  @param value The value to validate.
+ *
+ *  @param failedRule If the value is invalid and failedRule is not NULL,
+ *  set to the first rule the value failed, as written in the spec (for
+ *  example @"required" or @"min:3").
+ *
+ *  @returns YES if the value is valid, NO otherwise.
+ */
+- (BOOL)validateValue:(id)value failedRule:(NSString **)failedRule;
+
+@end
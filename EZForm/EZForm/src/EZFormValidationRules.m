@@ -0,0 +1,362 @@
+//
+//  EZForm
+//
+//  Copyright 2011-2013 Chris Miles. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "EZFormValidationRules.h"
+#import "EZFormCommonValidators.h"
+
+NSString * const EZFormValidationRulesErrorDomain = @"EZFormValidationRulesErrorDomain";
+
+typedef NS_ENUM(uint8_t, EZFormValidationRuleOpcode) {
+    EZFormValidationRuleOpcodeMin = 0,
+    EZFormValidationRuleOpcodeMax,
+    EZFormValidationRuleOpcodeEmail,
+    EZFormValidationRuleOpcodeNumeric,
+} ;
+
+
+#pragma mark - Value helpers
+
+static BOOL
+EZFormValidationValueIsEmpty(id value)
+{
+    if (nil == value || [value isKindOfClass:[NSNull class]]) {
+	return YES;
+    }
+    if ([value isKindOfClass:[NSString class]]) {
+	return ([(NSString *)value length] == 0);
+    }
+    if ([value isKindOfClass:[NSArray class]]) {
+	return ([(NSArray *)value count] == 0);
+    }
+    if ([value isKindOfClass:[NSDictionary class]]) {
+	return ([(NSDictionary *)value count] == 0);
+    }
+    if ([value isKindOfClass:[NSSet class]]) {
+	return ([(NSSet *)value count] == 0);
+    }
+    if ([value isKindOfClass:[NSOrderedSet class]]) {
+	return ([(NSOrderedSet *)value count] == 0);
+    }
+    return NO;
+}
+
+/* The quantity compared by the min and max rules: string length,
+ * collection count or numeric value.
+ */
+static BOOL
+EZFormValidationValueMagnitude(id value, double *magnitude)
+{
+    if ([value isKindOfClass:[NSString class]]) {
+	*magnitude = (double)[(NSString *)value length];
+    }
+    else if ([value isKindOfClass:[NSNumber class]]) {
+	*magnitude = [(NSNumber *)value doubleValue];
+    }
+    else if ([value isKindOfClass:[NSArray class]]) {
+	*magnitude = (double)[(NSArray *)value count];
+    }
+    else if ([value isKindOfClass:[NSDictionary class]]) {
+	*magnitude = (double)[(NSDictionary *)value count];
+    }
+    else if ([value isKindOfClass:[NSSet class]]) {
+	*magnitude = (double)[(NSSet *)value count];
+    }
+    else if ([value isKindOfClass:[NSOrderedSet class]]) {
+	*magnitude = (double)[(NSOrderedSet *)value count];
+    }
+    else {
+	return NO;
+    }
+    return YES;
+}
+
+/* Reads a number or a string of decimal digits, without allocating.
+ */
+static BOOL
+EZFormValidationValueNumericValue(id value, double *number)
+{
+    if ([value isKindOfClass:[NSNumber class]]) {
+	*number = [(NSNumber *)value doubleValue];
+	return YES;
+    }
+    if (! [value isKindOfClass:[NSString class]]) {
+	return NO;
+    }
+    
+    CFStringRef string = (__bridge CFStringRef)value;
+    CFIndex length = CFStringGetLength(string);
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer(string, &buffer, CFRangeMake(0, length));
+    
+    double result = 0.0;
+    for (CFIndex i=0; i < length; i++) {
+	UniChar c = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+	if (c < '0' || c > '9') {
+	    return NO;
+	}
+	result = result * 10.0 + (double)(c - '0');
+    }
+    *number = result;
+    return YES;
+}
+
+
+#pragma mark - EZFormValidationRules class extension
+
+@interface EZFormValidationRules () {
+    EZFormValidationRuleOpcode *_opcodes;
+    double *_operands; // two per rule: lower and upper bound
+    NSUInteger _ruleCount;
+    NSArray *_rules;
+    BOOL _requiresValue;
+}
+
+- (instancetype)initWithSpec:(NSString *)spec error:(NSError **)error;
+
+@end
+
+
+#pragma mark - EZFormValidationRules implementation
+
+@implementation EZFormValidationRules
+
+
+#pragma mark - Shared instances
+
++ (instancetype)validationRulesWithSpec:(NSString *)spec
+{
+    NSError *error = nil;
+    EZFormValidationRules *rules = [self validationRulesWithSpec:spec error:&error];
+    if (nil == rules) {
+	@throw [NSException exceptionWithName:NSInvalidArgumentException reason:[error localizedDescription] userInfo:nil];
+    }
+    return rules;
+}
+
++ (instancetype)validationRulesWithSpec:(NSString *)spec error:(NSError **)error
+{
+    static NSMapTable *compiledRules = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+	// Compiled rules live as long as some field holds on to them
+	compiledRules = [NSMapTable strongToWeakObjectsMapTable];
+    });
+    
+    NSParameterAssert(spec);
+    
+    EZFormValidationRules *rules = nil;
+    @synchronized(compiledRules) {
+	rules = [compiledRules objectForKey:spec];
+	if (nil == rules) {
+	    rules = [[self alloc] initWithSpec:spec error:error];
+	    if (rules) {
+		[compiledRules setObject:rules forKey:rules.spec];
+	    }
+	}
+    }
+    
+    return rules;
+}
+
+
+#pragma mark - Validation
+
+- (BOOL)validateValue:(id)value
+{
+    return ([self indexOfFailedRuleForValue:value] == NSNotFound);
+}
+
+- (BOOL)validateValue:(id)value failedRule:(NSString **)failedRule
+{
+    NSUInteger index = [self indexOfFailedRuleForValue:value];
+    if (index == NSNotFound) {
+	return YES;
+    }
+    
+    if (failedRule) {
+	*failedRule = (index < _ruleCount ? _rules[index] : @"required");
+    }
+    return NO;
+}
+
+/* Returns the index of the first failed rule, _ruleCount if a required
+ * value is missing, or NSNotFound if the value is valid.
+ */
+- (NSUInteger)indexOfFailedRuleForValue:(id)value
+{
+    if (EZFormValidationValueIsEmpty(value)) {
+	return (_requiresValue ? _ruleCount : NSNotFound);
+    }
+    
+    for (NSUInteger i=0; i < _ruleCount; i++) {
+	double lower = _operands[2*i];
+	double upper = _operands[2*i + 1];
+	double number = 0.0;
+	
+	switch (_opcodes[i]) {
+	    case EZFormValidationRuleOpcodeMin:
+		if (! EZFormValidationValueMagnitude(value, &number) || number < lower) return i;
+		break;
+		
+	    case EZFormValidationRuleOpcodeMax:
+		if (! EZFormValidationValueMagnitude(value, &number) || number > upper) return i;
+		break;
+		
+	    case EZFormValidationRuleOpcodeEmail:
+		if (! [value isKindOfClass:[NSString class]] || ! EZFormValidateEmailFormat(value)) return i;
+		break;
+		
+	    case EZFormValidationRuleOpcodeNumeric:
+		if (! EZFormValidationValueNumericValue(value, &number) || number < lower || number > upper) return i;
+		break;
+	}
+    }
+    
+    return NSNotFound;
+}
+
+
+#pragma mark - Parsing
+
++ (NSError *)invalidSpecError:(NSString *)spec reason:(NSString *)reason
+{
+    NSString *description = [NSString stringWithFormat:@"Invalid validation rules \"%@\": %@", spec, reason];
+    return [NSError errorWithDomain:EZFormValidationRulesErrorDomain code:EZFormValidationRulesErrorInvalidSpec userInfo:@{NSLocalizedDescriptionKey: description}];
+}
+
++ (BOOL)scanBound:(NSString *)string into:(double *)bound
+{
+    NSScanner *scanner = [NSScanner scannerWithString:string];
+    return ([scanner scanDouble:bound] && [scanner isAtEnd]);
+}
+
+- (BOOL)compileRule:(NSString *)rule atIndex:(NSUInteger)index error:(NSError **)error
+{
+    NSString *name = rule;
+    NSString *argument = nil;
+    NSRange colonRange = [rule rangeOfString:@":"];
+    if (colonRange.location != NSNotFound) {
+	name = [rule substringToIndex:colonRange.location];
+	argument = [rule substringFromIndex:NSMaxRange(colonRange)];
+    }
+    
+    double lower = -INFINITY;
+    double upper = INFINITY;
+    EZFormValidationRuleOpcode opcode;
+    
+    if ([name isEqualToString:@"min"] || [name isEqualToString:@"max"]) {
+	double bound = 0.0;
+	if (nil == argument || ! [[self class] scanBound:argument into:&bound]) {
+	    if (error) *error = [[self class] invalidSpecError:self.spec reason:[NSString stringWithFormat:@"rule \"%@\" needs a number", name]];
+	    return NO;
+	}
+	if ([name isEqualToString:@"min"]) {
+	    opcode = EZFormValidationRuleOpcodeMin;
+	    lower = bound;
+	}
+	else {
+	    opcode = EZFormValidationRuleOpcodeMax;
+	    upper = bound;
+	}
+    }
+    else if ([name isEqualToString:@"email"] && nil == argument) {
+	opcode = EZFormValidationRuleOpcodeEmail;
+    }
+    else if ([name isEqualToString:@"numeric"]) {
+	opcode = EZFormValidationRuleOpcodeNumeric;
+	if (argument) {
+	    NSRange rangeSeparator = [argument rangeOfString:@".."];
+	    if (rangeSeparator.location == NSNotFound) {
+		if (error) *error = [[self class] invalidSpecError:self.spec reason:@"numeric range must be of the form MIN..MAX"];
+		return NO;
+	    }
+	    NSString *lowerString = [argument substringToIndex:rangeSeparator.location];
+	    NSString *upperString = [argument substringFromIndex:NSMaxRange(rangeSeparator)];
+	    if (([lowerString length] > 0 && ! [[self class] scanBound:lowerString into:&lower]) ||
+		([upperString length] > 0 && ! [[self class] scanBound:upperString into:&upper])) {
+		if (error) *error = [[self class] invalidSpecError:self.spec reason:@"numeric range bounds must be numbers"];
+		return NO;
+	    }
+	}
+    }
+    else {
+	if (error) *error = [[self class] invalidSpecError:self.spec reason:[NSString stringWithFormat:@"unknown rule \"%@\"", rule]];
+	return NO;
+    }
+    
+    _opcodes[index] = opcode;
+    _operands[2*index] = lower;
+    _operands[2*index + 1] = upper;
+    return YES;
+}
+
+
+#pragma mark - Object lifecycle
+
+- (instancetype)initWithSpec:(NSString *)spec error:(NSError **)error
+{
+    if ((self = [super init])) {
+	_spec = [spec copy];
+	
+	NSMutableArray *rules = [NSMutableArray array];
+	for (NSString *component in [spec componentsSeparatedByString:@"|"]) {
+	    NSString *rule = [component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+	    if ([rule isEqualToString:@"required"]) {
+		_requiresValue = YES;
+	    }
+	    else if ([rule length] > 0) {
+		[rules addObject:rule];
+	    }
+	}
+	
+	_ruleCount = [rules count];
+	_rules = [rules copy];
+	_opcodes = calloc(MAX(_ruleCount, 1U), sizeof(EZFormValidationRuleOpcode));
+	_operands = calloc(MAX(_ruleCount, 1U) * 2, sizeof(double));
+	
+	for (NSUInteger i=0; i < _ruleCount; i++) {
+	    if (! [self compileRule:_rules[i] atIndex:i error:error]) {
+		return nil;
+	    }
+	}
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_opcodes);
+    free(_operands);
+}
+
+
+#pragma mark - NSObject methods
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p spec=\"%@\">", [self class], self, self.spec];
+}
+
+@end
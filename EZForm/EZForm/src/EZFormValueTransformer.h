@@ -21,6 +21,16 @@ typedef id(^EZFormValueTransformationBlock)(id value);
  **/
 @property (nonatomic, readonly, copy) EZFormValueTransformationBlock forwardBlock;
 
+/**
+ * Whether the transformer always returns the same output for the same input. Defaults to YES.
+ *
+ * Form fields cache the results of pure transformers until their value changes. Set this to NO if
+ * the blocks depend on anything other than their input, so the transformer is called on every read.
+ *
+ * Other NSValueTransformer subclasses are treated as pure unless they implement -isPure and return NO.
+**/
+@property (nonatomic, assign, getter=isPure) BOOL pure;
+
 
 /** @name Creating EZFormTransformers **/
 
@@ -7,6 +7,7 @@
 //
 
 #import "EZFormValueTransformer.h"
+#import "EZFormKeyPathAccessor.h"
 
 @implementation EZFormValueTransformer
 
@@ -25,6 +26,14 @@
 
 #pragma mark - Creating EZFormTransformers
 
+- (instancetype)init
+{
+    if ((self = [super init])) {
+        _pure = YES;
+    }
+    return self;
+}
+
 - (instancetype)initWithBlock:(EZFormValueTransformationBlock)block
 {
     if ((self = [self init])) {
@@ -40,6 +49,7 @@
 
 + (instancetype)valueTransformerWithKeyPath:(NSString *)keyPath
 {
+    EZFormKeyPathAccessor *accessor = [EZFormKeyPathAccessor accessorWithKeyPath:keyPath];
     return [self valueTransformerWithBlock:^id(id input) {
         
         if (input == nil) {
@@ -58,20 +68,22 @@
                 return input;
             }
             
-            NSMutableArray *keys = [NSMutableArray array];
+            NSMutableArray *keys = [NSMutableArray arrayWithCapacity:[(NSArray *)input count]];
             for (id i in (NSArray *)input) {
-                [keys addObject:[i valueForKeyPath:keyPath]];
+                [keys addObject:[accessor valueForObject:i]];
             }
             return [keys copy];
         }
         
-        id value = [input valueForKeyPath:keyPath];
+        id value = [accessor valueForObject:input];
         return value;
     }];
 }
 
 + (instancetype)valueTransformerWithKeyPathForValue:(NSString *)keyPath keyPathForDisplayValue:(NSString *)displayKeyPath
 {
+    EZFormKeyPathAccessor *accessor = [EZFormKeyPathAccessor accessorWithKeyPath:keyPath];
+    EZFormKeyPathAccessor *displayAccessor = [EZFormKeyPathAccessor accessorWithKeyPath:displayKeyPath];
     return [self valueTransformerWithBlock:^id(id input) {
         
         if (input == nil)
@@ -87,19 +99,19 @@
             if ([((NSArray *)input).firstObject isKindOfClass:[NSString class]])
                 return input;
             
-            NSMutableDictionary *choices = [[NSMutableDictionary alloc] initWithCapacity:0];
+            NSMutableDictionary *choices = [[NSMutableDictionary alloc] initWithCapacity:[(NSArray *)input count]];
             for (id i in (NSArray *)input) {
                 
-                id<NSCopying> value = [i valueForKeyPath:keyPath];
-                id displayValue = [i valueForKeyPath:displayKeyPath];
+                id<NSCopying> value = [accessor valueForObject:i];
+                id displayValue = [displayAccessor valueForObject:i];
                 
                 [choices setObject:(displayValue ?: value) forKey:value];
             }
             return [choices copy];
         }
         
-        id<NSCopying> value = [input valueForKeyPath:keyPath];
-        id displayValue = [input valueForKeyPath:displayKeyPath];
+        id<NSCopying> value = [accessor valueForObject:input];
+        id displayValue = [displayAccessor valueForObject:input];
         
         return @{ value: (displayValue ?: value) };
     }];